@@ -0,0 +1,151 @@
+//
+//  AsyncRingBuffer.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef AsyncRingBuffer_h
+#define AsyncRingBuffer_h
+
+#include "RingBuffer.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <mutex>
+#include <optional>
+
+namespace Details {
+
+// resumes the waiter right on the thread which released it
+struct rb_inline_executor
+{
+    void post(std::coroutine_handle<> handle)
+    {
+        handle.resume();
+    }
+};
+
+}
+
+// Bounded channel over ring storage.
+// co_await pop() suspends while the ring is empty, co_await push(x) while it is full.
+// Waiters are released in FIFO order and resumed through Executor::post,
+// always after the internal lock is dropped.
+template
+    <
+        class T
+        , class Executor = Details::rb_inline_executor
+        , class Alloc = std::allocator<T>
+    >
+class AsyncRingBuffer
+{
+public:
+    typedef Executor executor_type;
+    typedef typename RingBuffer<T, Alloc>::value_type value_type;
+    typedef typename RingBuffer<T, Alloc>::size_type size_type;
+
+    explicit AsyncRingBuffer
+        (
+            size_type capacity
+            , const Executor &executor = Executor()
+            , const Alloc &alloc = Alloc()
+        );
+    AsyncRingBuffer(const AsyncRingBuffer &) = delete;
+    AsyncRingBuffer &operator=(const AsyncRingBuffer &) = delete;
+    ~AsyncRingBuffer();
+
+private:
+    struct waiter
+    {
+        waiter *m_next = nullptr;
+        Executor *m_executor = nullptr;
+        std::coroutine_handle<> m_handle;
+        bool m_closed = false;
+    };
+
+    struct waiter_queue
+    {
+        waiter *m_head = nullptr;
+        waiter *m_tail = nullptr;
+
+        bool empty() const;
+        void push(waiter *);
+        waiter *pop();
+    };
+
+public:
+    class pop_awaiter : private waiter
+    {
+    public:
+        friend class AsyncRingBuffer;
+
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> handle);
+        T await_resume();
+
+    private:
+        pop_awaiter(AsyncRingBuffer &owner, Executor &executor);
+
+        AsyncRingBuffer &m_owner;
+        std::optional<T> m_value;
+    };
+
+    class push_awaiter : private waiter
+    {
+    public:
+        friend class AsyncRingBuffer;
+
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume();
+
+    private:
+        push_awaiter(AsyncRingBuffer &owner, Executor &executor, T &&value);
+
+        AsyncRingBuffer &m_owner;
+        T m_value;
+    };
+
+    pop_awaiter pop();
+    pop_awaiter pop(Executor &executor);
+    push_awaiter push(T value);
+    push_awaiter push(T value, Executor &executor);
+
+    bool try_pop(T &value);
+    bool try_push(T value);
+    // pushes as many elements as fit, waking all released consumers in one pass
+    template<class InputIt>
+    InputIt try_push_range(InputIt first, InputIt last);
+
+    // wakes every waiter; pending and later pushes and pops on an empty ring throw
+    void close();
+    bool closed() const;
+
+    size_type size() const;
+    size_type capacity() const;
+
+private:
+    // both expect m_mutex to be held, released waiters are linked into ready
+    bool pop_locked(std::optional<T> &value, waiter_queue &ready);
+    bool push_locked(T &&value, waiter_queue &ready);
+
+    static void resume_all(waiter_queue &ready);
+
+// data
+private:
+    mutable std::mutex m_mutex;
+    RingBuffer<T, Alloc> m_buffer;
+    Executor m_executor;
+    waiter_queue m_popWaiters;
+    waiter_queue m_pushWaiters;
+    bool m_closed;
+};
+
+#include "AsyncRingBuffer.hpp"
+
+#endif /* __cpp_impl_coroutine */
+
+#endif /* AsyncRingBuffer_h */
@@ -0,0 +1,323 @@
+#include "AsyncRingBuffer.h"
+#include <stdexcept>
+#include <cassert>
+
+#define ARB_IMP AsyncRingBuffer<T, Executor, Alloc>
+
+template<class T, class Executor, class Alloc>
+ARB_IMP::AsyncRingBuffer(size_type capacity, const Executor &executor, const Alloc &alloc)
+    : m_buffer(capacity, alloc)
+    , m_executor(executor)
+    , m_closed(false)
+{
+}
+
+template<class T, class Executor, class Alloc>
+ARB_IMP::~AsyncRingBuffer()
+{
+    assert(m_popWaiters.empty() && m_pushWaiters.empty());
+}
+
+// waiter queue
+
+template<class T, class Executor, class Alloc>
+bool ARB_IMP::waiter_queue::empty() const
+{
+    return m_head == nullptr;
+}
+
+template<class T, class Executor, class Alloc>
+void ARB_IMP::waiter_queue::push(waiter *w)
+{
+    w->m_next = nullptr;
+    if (m_tail)
+        m_tail->m_next = w;
+    else
+        m_head = w;
+    m_tail = w;
+}
+
+template<class T, class Executor, class Alloc>
+typename ARB_IMP::waiter *ARB_IMP::waiter_queue::pop()
+{
+    waiter *w = m_head;
+    if (w)
+    {
+        m_head = w->m_next;
+        if (!m_head)
+            m_tail = nullptr;
+    }
+    return w;
+}
+
+// awaiters
+
+template<class T, class Executor, class Alloc>
+ARB_IMP::pop_awaiter::pop_awaiter(AsyncRingBuffer &owner, Executor &executor)
+    : m_owner(owner)
+{
+    this->m_executor = &executor;
+}
+
+template<class T, class Executor, class Alloc>
+bool ARB_IMP::pop_awaiter::await_ready() const noexcept
+{
+    return false;
+}
+
+template<class T, class Executor, class Alloc>
+bool ARB_IMP::pop_awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    waiter_queue ready;
+    {
+        std::lock_guard<std::mutex> lock(m_owner.m_mutex);
+        if (!m_owner.pop_locked(m_value, ready))
+        {
+            if (m_owner.m_closed)
+            {
+                this->m_closed = true;
+                return false;
+            }
+
+            // from here on the coroutine may be resumed by another thread
+            this->m_handle = handle;
+            m_owner.m_popWaiters.push(this);
+            return true;
+        }
+    }
+
+    resume_all(ready);
+    return false;
+}
+
+template<class T, class Executor, class Alloc>
+T ARB_IMP::pop_awaiter::await_resume()
+{
+    if (!m_value)
+        throw std::range_error("ring buffer is closed");
+
+    return std::move(*m_value);
+}
+
+template<class T, class Executor, class Alloc>
+ARB_IMP::push_awaiter::push_awaiter(AsyncRingBuffer &owner, Executor &executor, T &&value)
+    : m_owner(owner)
+    , m_value(std::move(value))
+{
+    this->m_executor = &executor;
+}
+
+template<class T, class Executor, class Alloc>
+bool ARB_IMP::push_awaiter::await_ready() const noexcept
+{
+    return false;
+}
+
+template<class T, class Executor, class Alloc>
+bool ARB_IMP::push_awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    waiter_queue ready;
+    {
+        std::lock_guard<std::mutex> lock(m_owner.m_mutex);
+        if (m_owner.m_closed)
+        {
+            this->m_closed = true;
+            return false;
+        }
+
+        if (!m_owner.push_locked(std::move(m_value), ready))
+        {
+            this->m_handle = handle;
+            m_owner.m_pushWaiters.push(this);
+            return true;
+        }
+    }
+
+    resume_all(ready);
+    return false;
+}
+
+template<class T, class Executor, class Alloc>
+void ARB_IMP::push_awaiter::await_resume()
+{
+    if (this->m_closed)
+        throw std::range_error("ring buffer is closed");
+}
+
+// channel
+
+template<class T, class Executor, class Alloc>
+typename ARB_IMP::pop_awaiter ARB_IMP::pop()
+{
+    return pop_awaiter(*this, m_executor);
+}
+
+template<class T, class Executor, class Alloc>
+typename ARB_IMP::pop_awaiter ARB_IMP::pop(Executor &executor)
+{
+    return pop_awaiter(*this, executor);
+}
+
+template<class T, class Executor, class Alloc>
+typename ARB_IMP::push_awaiter ARB_IMP::push(T value)
+{
+    return push_awaiter(*this, m_executor, std::move(value));
+}
+
+template<class T, class Executor, class Alloc>
+typename ARB_IMP::push_awaiter ARB_IMP::push(T value, Executor &executor)
+{
+    return push_awaiter(*this, executor, std::move(value));
+}
+
+template<class T, class Executor, class Alloc>
+bool ARB_IMP::try_pop(T &value)
+{
+    std::optional<T> popped;
+    waiter_queue ready;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!pop_locked(popped, ready))
+            return false;
+    }
+
+    resume_all(ready);
+    value = std::move(*popped);
+    return true;
+}
+
+template<class T, class Executor, class Alloc>
+bool ARB_IMP::try_push(T value)
+{
+    waiter_queue ready;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed || !push_locked(std::move(value), ready))
+            return false;
+    }
+
+    resume_all(ready);
+    return true;
+}
+
+template<class T, class Executor, class Alloc>
+template<class InputIt>
+InputIt ARB_IMP::try_push_range(InputIt first, InputIt last)
+{
+    waiter_queue ready;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed)
+            return first;
+
+        for (; first != last; ++first)
+        {
+            T value = *first;
+            if (!push_locked(std::move(value), ready))
+                break;
+        }
+    }
+
+    resume_all(ready);
+    return first;
+}
+
+template<class T, class Executor, class Alloc>
+void ARB_IMP::close()
+{
+    waiter_queue ready;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        while (waiter *w = m_popWaiters.pop())
+        {
+            w->m_closed = true;
+            ready.push(w);
+        }
+        while (waiter *w = m_pushWaiters.pop())
+        {
+            w->m_closed = true;
+            ready.push(w);
+        }
+    }
+
+    resume_all(ready);
+}
+
+template<class T, class Executor, class Alloc>
+bool ARB_IMP::closed() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_closed;
+}
+
+template<class T, class Executor, class Alloc>
+typename ARB_IMP::size_type ARB_IMP::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_buffer.size();
+}
+
+template<class T, class Executor, class Alloc>
+typename ARB_IMP::size_type ARB_IMP::capacity() const
+{
+    return m_buffer.capacity();
+}
+
+template<class T, class Executor, class Alloc>
+bool ARB_IMP::pop_locked(std::optional<T> &value, waiter_queue &ready)
+{
+    if (!m_buffer.empty())
+    {
+        value.emplace(std::move(m_buffer.front()));
+        m_buffer.pop_front();
+
+        // the slot just freed goes to the oldest blocked producer
+        if (waiter *w = m_pushWaiters.pop())
+        {
+            m_buffer.push_back(std::move(static_cast<push_awaiter *>(w)->m_value));
+            ready.push(w);
+        }
+        return true;
+    }
+
+    // zero capacity ring, take the value straight from the producer
+    if (waiter *w = m_pushWaiters.pop())
+    {
+        value.emplace(std::move(static_cast<push_awaiter *>(w)->m_value));
+        ready.push(w);
+        return true;
+    }
+
+    return false;
+}
+
+template<class T, class Executor, class Alloc>
+bool ARB_IMP::push_locked(T &&value, waiter_queue &ready)
+{
+    // consumers wait only on an empty ring, so hand the value over directly
+    if (waiter *w = m_popWaiters.pop())
+    {
+        static_cast<pop_awaiter *>(w)->m_value.emplace(std::move(value));
+        ready.push(w);
+        return true;
+    }
+
+    if (m_buffer.size() < m_buffer.capacity())
+    {
+        m_buffer.push_back(std::move(value));
+        return true;
+    }
+
+    return false;
+}
+
+template<class T, class Executor, class Alloc>
+void ARB_IMP::resume_all(waiter_queue &ready)
+{
+    // the waiter may be destroyed by its resumption, so unlink it first
+    while (waiter *w = ready.pop())
+        w->m_executor->post(w->m_handle);
+}
+
+#undef ARB_IMP
@@ -0,0 +1,152 @@
+//
+//  ChunkedRingBuffer.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef ChunkedRingBuffer_h
+#define ChunkedRingBuffer_h
+
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+// Unbounded FIFO with the RingBuffer interface, built from a chain of
+// fixed size blocks. It grows by linking one more block and shrinks by
+// unlinking drained blocks, so elements are never copied on growth.
+// Drained blocks are kept in a pool for reuse, blocks beyond the pool
+// limit go back to the allocator.
+template<class T, class Alloc = std::allocator<T>>
+class ChunkedRingBuffer
+{
+public:
+    typedef Alloc allocator_type;
+    typedef typename Alloc::value_type value_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef typename Alloc::difference_type difference_type;
+    typedef typename Alloc::size_type size_type;
+
+    explicit ChunkedRingBuffer
+        (
+            size_type blockSize = 1024
+            , size_type pooledBlocks = 2
+            , const Alloc &alloc = Alloc()
+        );
+    ChunkedRingBuffer(const ChunkedRingBuffer &other);
+    ChunkedRingBuffer &operator=(const ChunkedRingBuffer &other);
+    ChunkedRingBuffer(ChunkedRingBuffer &&other);
+    ChunkedRingBuffer &operator=(ChunkedRingBuffer &&other);
+    ~ChunkedRingBuffer();
+
+    reference front();
+    const_reference front() const;
+    reference back();
+    const_reference back() const;
+    reference operator[](size_type);
+    const_reference operator[](size_type) const;
+
+    void clear();
+    void push_back(const T&);
+    void push_back(T&&);
+    template<class ...Args>
+    void emplace_back(Args&&...);
+    void pop_front();
+
+    void swap(ChunkedRingBuffer &other) noexcept;
+    size_type size() const;
+    // slots in linked blocks, pooled blocks not counted
+    size_type capacity() const;
+    bool empty() const;
+    size_type block_size() const;
+    size_type pooled_blocks() const;
+    // returns every pooled block to the allocator
+    void shrink_to_fit();
+
+private:
+    template<class Owner, class Pointer, class Reference>
+    class iteratorImp {
+    public:
+        typedef ChunkedRingBuffer::difference_type difference_type;
+        typedef ChunkedRingBuffer::value_type value_type;
+        typedef Reference reference;
+        typedef Pointer pointer;
+        typedef std::random_access_iterator_tag iterator_category;
+        friend class ChunkedRingBuffer;
+
+        iteratorImp();
+    private:
+        iteratorImp(Owner *owner, size_type current);
+    public:
+
+        bool operator==(const iteratorImp&) const;
+        bool operator!=(const iteratorImp&) const;
+        bool operator<(const iteratorImp&) const;
+        bool operator>(const iteratorImp&) const;
+        bool operator<=(const iteratorImp&) const;
+        bool operator>=(const iteratorImp&) const;
+
+        iteratorImp& operator++();
+        iteratorImp operator++(int);
+        iteratorImp& operator--();
+        iteratorImp operator--(int);
+        iteratorImp& operator+=(size_type);
+        iteratorImp operator+(size_type) const;
+
+        friend iteratorImp operator+(size_type pos, const iteratorImp &it)
+        {
+            return it + pos;
+        }
+
+        iteratorImp& operator-=(size_type);
+        iteratorImp operator-(size_type) const;
+        difference_type operator-(const iteratorImp &) const;
+
+        Reference operator*() const;
+        Pointer operator->() const;
+        Reference operator[](size_type) const;
+
+    private:
+        Owner *m_owner;
+        size_type m_current;
+    };
+public:
+
+    using iterator = iteratorImp<ChunkedRingBuffer, T*, reference>;
+    using const_iterator = iteratorImp<const ChunkedRingBuffer, const T*, const_reference>;
+
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const;
+
+private:
+    T *slot(size_type pos) const;
+
+    T *acquire_block();
+    void release_block(T *block);
+    void release_all();
+
+    // links a new block when the last one is full, returns the free slot
+    T *back_slot();
+
+// data
+private:
+    std::deque<T*> m_blocks;
+    std::vector<T*> m_pool;
+
+    size_type m_blockSize;
+    size_type m_pooledBlocks;
+    size_type m_start;      // offset of the front element in the first block
+    size_type m_size;
+    Alloc m_allocator;
+};
+
+#include "ChunkedRingBuffer.hpp"
+
+#endif /* ChunkedRingBuffer_h */
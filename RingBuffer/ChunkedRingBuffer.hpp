@@ -0,0 +1,496 @@
+#include "ChunkedRingBuffer.h"
+#include <cassert>
+#include <stdexcept>
+
+#define CRB_IMP ChunkedRingBuffer<T, Alloc>
+#define CRB_IT_IMP ChunkedRingBuffer<T, Alloc>::iteratorImp<Owner, Pointer, Reference>
+#define CRB_IT_RET typename ChunkedRingBuffer<T, Alloc>::template iteratorImp<Owner, Pointer, Reference>
+
+template<class T, class Alloc>
+CRB_IMP::ChunkedRingBuffer(size_type blockSize, size_type pooledBlocks, const Alloc &alloc)
+    : m_blockSize(blockSize)
+    , m_pooledBlocks(pooledBlocks)
+    , m_start(0)
+    , m_size(0)
+    , m_allocator(alloc)
+{
+    if (m_blockSize == 0)
+        throw std::invalid_argument("chunked ring buffer block size is zero");
+}
+
+template<class T, class Alloc>
+CRB_IMP::ChunkedRingBuffer(const ChunkedRingBuffer &other)
+    : m_blockSize(other.m_blockSize)
+    , m_pooledBlocks(other.m_pooledBlocks)
+    , m_start(0)
+    , m_size(0)
+    , m_allocator(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.m_allocator))
+{
+    for (size_type pos = 0; pos < other.m_size; ++pos)
+        push_back(other[pos]);
+}
+
+template<class T, class Alloc>
+CRB_IMP &ChunkedRingBuffer<T, Alloc>::operator=(const ChunkedRingBuffer &other)
+{
+    auto temp = other;
+    swap(temp);
+    return *this;
+}
+
+template<class T, class Alloc>
+CRB_IMP::ChunkedRingBuffer(ChunkedRingBuffer &&other)
+    : m_blocks(std::move(other.m_blocks))
+    , m_pool(std::move(other.m_pool))
+    , m_blockSize(other.m_blockSize)
+    , m_pooledBlocks(other.m_pooledBlocks)
+    , m_start(other.m_start)
+    , m_size(other.m_size)
+    , m_allocator(std::move(other.m_allocator))
+{
+    other.m_blocks.clear();
+    other.m_pool.clear();
+    other.m_start = 0;
+    other.m_size = 0;
+}
+
+template<class T, class Alloc>
+CRB_IMP &ChunkedRingBuffer<T, Alloc>::operator=(ChunkedRingBuffer &&other)
+{
+    auto temp = std::move(other);
+    swap(temp);
+    return *this;
+}
+
+template<class T, class Alloc>
+CRB_IMP::~ChunkedRingBuffer()
+{
+    clear();
+    shrink_to_fit();
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::reference ChunkedRingBuffer<T, Alloc>::front()
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    return *slot(0);
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::const_reference ChunkedRingBuffer<T, Alloc>::front() const
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    return *slot(0);
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::reference ChunkedRingBuffer<T, Alloc>::back()
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    return *slot(m_size - 1);
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::const_reference ChunkedRingBuffer<T, Alloc>::back() const
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    return *slot(m_size - 1);
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::reference ChunkedRingBuffer<T, Alloc>::operator[](size_type pos)
+{
+    return *slot(pos);
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::const_reference ChunkedRingBuffer<T, Alloc>::operator[](size_type pos) const
+{
+    return *slot(pos);
+}
+
+template<class T, class Alloc>
+void CRB_IMP::clear()
+{
+    for (size_type pos = 0; pos < m_size; ++pos)
+    {
+        std::allocator_traits<Alloc>::destroy
+        (
+            m_allocator
+            , slot(pos)
+        );
+    }
+
+    m_size = 0;
+    release_all();
+}
+
+template<class T, class Alloc>
+void CRB_IMP::push_back(const T &value)
+{
+    emplace_back(value);
+}
+
+template<class T, class Alloc>
+void CRB_IMP::push_back(T &&value)
+{
+    emplace_back(std::move(value));
+}
+
+template<class T, class Alloc>
+template<class... Args>
+void CRB_IMP::emplace_back(Args&&... args)
+{
+    std::allocator_traits<Alloc>::construct
+    (
+        m_allocator
+        , back_slot()
+        , std::forward<Args>(args)...
+    );
+    ++m_size;
+}
+
+template<class T, class Alloc>
+void CRB_IMP::pop_front()
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    std::allocator_traits<Alloc>::destroy
+    (
+        m_allocator
+        , m_blocks.front() + m_start
+    );
+    ++m_start;
+    --m_size;
+
+    if (m_size == 0)
+        release_all();
+    else if (m_start == m_blockSize)
+    {
+        release_block(m_blocks.front());
+        m_blocks.pop_front();
+        m_start = 0;
+    }
+}
+
+template<class T, class Alloc>
+void CRB_IMP::swap(ChunkedRingBuffer &other) noexcept
+{
+    std::swap(m_blocks, other.m_blocks);
+    std::swap(m_pool, other.m_pool);
+    std::swap(m_blockSize, other.m_blockSize);
+    std::swap(m_pooledBlocks, other.m_pooledBlocks);
+    std::swap(m_start, other.m_start);
+    std::swap(m_size, other.m_size);
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::size_type ChunkedRingBuffer<T, Alloc>::size() const
+{
+    return m_size;
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::size_type ChunkedRingBuffer<T, Alloc>::capacity() const
+{
+    return m_blocks.size() * m_blockSize;
+}
+
+template<class T, class Alloc>
+bool CRB_IMP::empty() const
+{
+    return m_size == 0;
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::size_type ChunkedRingBuffer<T, Alloc>::block_size() const
+{
+    return m_blockSize;
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::size_type ChunkedRingBuffer<T, Alloc>::pooled_blocks() const
+{
+    return m_pool.size();
+}
+
+template<class T, class Alloc>
+void CRB_IMP::shrink_to_fit()
+{
+    for (auto block : m_pool)
+    {
+        std::allocator_traits<Alloc>::deallocate
+        (
+            m_allocator
+            , block
+            , m_blockSize
+        );
+    }
+    m_pool.clear();
+}
+
+// iterators
+
+template<class T, class Alloc>
+typename CRB_IMP::iterator ChunkedRingBuffer<T, Alloc>::begin()
+{
+    return iterator(this, 0);
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::const_iterator ChunkedRingBuffer<T, Alloc>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::const_iterator ChunkedRingBuffer<T, Alloc>::cbegin() const
+{
+    return begin();
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::iterator ChunkedRingBuffer<T, Alloc>::end()
+{
+    return iterator(this, m_size);
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::const_iterator ChunkedRingBuffer<T, Alloc>::end() const
+{
+    return const_iterator(this, m_size);
+}
+
+template<class T, class Alloc>
+typename CRB_IMP::const_iterator ChunkedRingBuffer<T, Alloc>::cend() const
+{
+    return end();
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+CRB_IT_IMP::iteratorImp()
+    : m_owner(nullptr)
+    , m_current(0)
+{
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+CRB_IT_IMP::iteratorImp(Owner *owner, size_type current)
+    : m_owner(owner)
+    , m_current(current)
+{
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+bool CRB_IT_IMP::operator==(const iteratorImp &other) const
+{
+    return m_owner == other.m_owner && m_current == other.m_current;
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+bool CRB_IT_IMP::operator!=(const iteratorImp &other) const
+{
+    return !(operator==(other));
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+bool CRB_IT_IMP::operator<(const iteratorImp &other) const
+{
+    assert(m_owner == other.m_owner);
+    return m_current < other.m_current;
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+bool CRB_IT_IMP::operator>(const iteratorImp &other) const
+{
+    return other < *this;
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+bool CRB_IT_IMP::operator<=(const iteratorImp &other) const
+{
+    return !(operator>(other));
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+bool CRB_IT_IMP::operator>=(const iteratorImp &other) const
+{
+    return !(operator<(other));
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+CRB_IT_RET &CRB_IT_IMP::operator++()
+{
+    ++m_current;
+    return *this;
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+CRB_IT_RET CRB_IT_IMP::operator++(int)
+{
+    auto temp = *this;
+    ++m_current;
+    return temp;
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+CRB_IT_RET &CRB_IT_IMP::operator--()
+{
+    --m_current;
+    return *this;
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+CRB_IT_RET CRB_IT_IMP::operator--(int)
+{
+    auto temp = *this;
+    --m_current;
+    return temp;
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+CRB_IT_RET &CRB_IT_IMP::operator+=(size_type pos)
+{
+    m_current += pos;
+    return *this;
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+CRB_IT_RET CRB_IT_IMP::operator+(size_type pos) const
+{
+    return iteratorImp(m_owner, m_current + pos);
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+CRB_IT_RET &CRB_IT_IMP::operator-=(size_type pos)
+{
+    m_current -= pos;
+    return *this;
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+CRB_IT_RET CRB_IT_IMP::operator-(size_type pos) const
+{
+    return iteratorImp(m_owner, m_current - pos);
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+typename CRB_IMP::difference_type CRB_IT_IMP::operator-(const iteratorImp &other) const
+{
+    return difference_type(m_current) - difference_type(other.m_current);
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+Reference CRB_IT_IMP::operator*() const
+{
+    return *m_owner->slot(m_current);
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+Pointer CRB_IT_IMP::operator->() const
+{
+    return m_owner->slot(m_current);
+}
+
+template<class T, class Alloc>
+template<class Owner, class Pointer, class Reference>
+Reference CRB_IT_IMP::operator[](size_type pos) const
+{
+    return *m_owner->slot(m_current + pos);
+}
+
+// imps
+
+template<class T, class Alloc>
+T *CRB_IMP::slot(size_type pos) const
+{
+    pos += m_start;
+    return m_blocks[pos / m_blockSize] + pos % m_blockSize;
+}
+
+template<class T, class Alloc>
+T *CRB_IMP::acquire_block()
+{
+    if (m_pool.empty())
+    {
+        return std::allocator_traits<Alloc>::allocate
+        (
+            m_allocator
+            , m_blockSize
+        );
+    }
+
+    T *block = m_pool.back();
+    m_pool.pop_back();
+    return block;
+}
+
+template<class T, class Alloc>
+void CRB_IMP::release_block(T *block)
+{
+    if (m_pool.size() < m_pooledBlocks)
+    {
+        m_pool.push_back(block);
+        return;
+    }
+
+    std::allocator_traits<Alloc>::deallocate
+    (
+        m_allocator
+        , block
+        , m_blockSize
+    );
+}
+
+template<class T, class Alloc>
+void CRB_IMP::release_all()
+{
+    assert(m_size == 0);
+    for (auto block : m_blocks)
+        release_block(block);
+
+    m_blocks.clear();
+    m_start = 0;
+}
+
+template<class T, class Alloc>
+T *CRB_IMP::back_slot()
+{
+    auto end = m_start + m_size;
+    if (end == m_blocks.size() * m_blockSize)
+        m_blocks.push_back(acquire_block());
+
+    return m_blocks[end / m_blockSize] + end % m_blockSize;
+}
+
+#undef CRB_IMP
+#undef CRB_IT_IMP
+#undef CRB_IT_RET
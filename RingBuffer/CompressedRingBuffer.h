@@ -0,0 +1,195 @@
+//
+//  CompressedRingBuffer.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef CompressedRingBuffer_h
+#define CompressedRingBuffer_h
+
+#include "RingBuffer.h"
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+// Ring of numeric samples kept in compressed blocks of block_size() values.
+// Integers are stored as zigzagged delta-of-delta, floating point values as
+// the XOR with the previous value (the Gorilla encodings), so regular
+// timestamps cost about one bit and repeated prices one bit per sample.
+// The newest block is kept plain for fast appends and is encoded when it
+// fills up; once block_count() blocks are stored, the oldest whole block
+// is evicted and its storage is reused for the next one. Iteration decodes
+// on the fly, advancing an iterator skips whole blocks without decoding.
+
+namespace Details {
+
+class crb_bit_writer
+{
+public:
+    explicit crb_bit_writer(std::vector<std::uint64_t> &words);
+    // low bits of value, bits in [0, 64]
+    void write(std::uint64_t value, unsigned bits);
+
+private:
+    std::vector<std::uint64_t> &m_words;
+    std::size_t m_bits;
+};
+
+class crb_bit_reader
+{
+public:
+    crb_bit_reader();
+    explicit crb_bit_reader(const std::uint64_t *words);
+    std::uint64_t read(unsigned bits);
+
+private:
+    const std::uint64_t *m_words;
+    std::size_t m_bits;
+};
+
+// delta-of-delta for integers, XOR for floating point
+template<class T, bool floating = std::is_floating_point<T>::value>
+struct crb_codec;
+
+template<class T>
+struct crb_codec<T, false>
+{
+    struct encoder
+    {
+        void first(T value);
+        void next(crb_bit_writer &writer, T value);
+
+        std::uint64_t m_previous;
+        std::uint64_t m_delta;
+    };
+
+    struct decoder
+    {
+        T first(T value);
+        T next(crb_bit_reader &reader);
+
+        std::uint64_t m_previous;
+        std::uint64_t m_delta;
+    };
+};
+
+template<class T>
+struct crb_codec<T, true>
+{
+    typedef typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type bits_type;
+    static const unsigned width = sizeof(T) * 8;
+
+    struct encoder
+    {
+        void first(T value);
+        void next(crb_bit_writer &writer, T value);
+
+        bits_type m_previous;
+        unsigned m_leading;
+        unsigned m_trailing;
+    };
+
+    struct decoder
+    {
+        T first(T value);
+        T next(crb_bit_reader &reader);
+
+        bits_type m_previous;
+        unsigned m_leading;
+        unsigned m_trailing;
+    };
+};
+
+}
+
+template<class T>
+class CompressedRingBuffer
+{
+    static_assert(std::is_arithmetic<T>::value && sizeof(T) <= 8, "compressed ring buffer stores integers or floating point values");
+    static_assert(!std::is_floating_point<T>::value || sizeof(T) == 4 || sizeof(T) == 8, "only float and double are supported");
+
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    // keeps between blockCount * blockSize and one block less than
+    // (blockCount + 1) * blockSize of the newest values
+    explicit CompressedRingBuffer(size_type blockCount, size_type blockSize = 1024);
+
+    T front() const;
+    T back() const;
+
+    void clear();
+    void push_back(T value);
+
+    size_type size() const;
+    bool empty() const;
+    size_type block_count() const;
+    size_type block_size() const;
+    // bytes held by stored blocks and the plain newest block
+    size_type memory_usage() const;
+
+    class const_iterator
+    {
+    public:
+        typedef CompressedRingBuffer::difference_type difference_type;
+        typedef CompressedRingBuffer::value_type value_type;
+        typedef const T &reference;
+        typedef const T *pointer;
+        typedef std::forward_iterator_tag iterator_category;
+        friend class CompressedRingBuffer;
+
+        const_iterator();
+
+        bool operator==(const const_iterator &) const;
+        bool operator!=(const const_iterator &) const;
+
+        const_iterator &operator++();
+        const_iterator operator++(int);
+        // whole blocks are skipped without decoding
+        const_iterator &operator+=(size_type);
+        const_iterator operator+(size_type) const;
+
+        reference operator*() const;
+        pointer operator->() const;
+
+    private:
+        const_iterator(const CompressedRingBuffer *owner, size_type block);
+        void load();
+
+        const CompressedRingBuffer *m_owner;
+        size_type m_block;   // block_count() stands for the plain block
+        size_type m_offset;
+        T m_value;
+        typename Details::crb_codec<T>::decoder m_decoder;
+        Details::crb_bit_reader m_reader;
+    };
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    struct block
+    {
+        std::vector<std::uint64_t> m_words;
+        T m_first;
+    };
+
+    void flush();
+
+// data
+private:
+    RingBuffer<block> m_blocks;
+    std::vector<T> m_plain;
+    // storage of the last evicted block, reused by the next flush
+    std::vector<std::uint64_t> m_spare;
+    size_type m_blockSize;
+};
+
+#include "CompressedRingBuffer.hpp"
+
+#endif /* CompressedRingBuffer_h */
@@ -0,0 +1,496 @@
+#include "CompressedRingBuffer.h"
+#include <cstring>
+#include <stdexcept>
+
+#define CRB_COMP_IMP CompressedRingBuffer<T>
+#define CRB_COMP_IT_IMP CompressedRingBuffer<T>::const_iterator
+
+namespace Details {
+
+inline unsigned crb_leading_zeros(std::uint64_t value)
+{
+#if defined(__GNUC__)
+    return unsigned(__builtin_clzll(value));
+#else
+    unsigned count = 0;
+    for (std::uint64_t bit = std::uint64_t(1) << 63; !(value & bit); bit >>= 1)
+        ++count;
+    return count;
+#endif
+}
+
+inline unsigned crb_trailing_zeros(std::uint64_t value)
+{
+#if defined(__GNUC__)
+    return unsigned(__builtin_ctzll(value));
+#else
+    unsigned count = 0;
+    for (; !(value & 1); value >>= 1)
+        ++count;
+    return count;
+#endif
+}
+
+inline std::uint64_t crb_mask(unsigned bits)
+{
+    return bits < 64 ? (std::uint64_t(1) << bits) - 1 : ~std::uint64_t(0);
+}
+
+inline crb_bit_writer::crb_bit_writer(std::vector<std::uint64_t> &words)
+    : m_words(words)
+    , m_bits(0)
+{
+    m_words.clear();
+}
+
+inline void crb_bit_writer::write(std::uint64_t value, unsigned bits)
+{
+    if (bits == 0)
+        return;
+
+    value &= crb_mask(bits);
+    auto word = m_bits / 64;
+    auto offset = unsigned(m_bits % 64);
+
+    if (offset == 0)
+        m_words.push_back(value);
+    else
+    {
+        m_words[word] |= value << offset;
+        if (offset + bits > 64)
+            m_words.push_back(value >> (64 - offset));
+    }
+    m_bits += bits;
+}
+
+inline crb_bit_reader::crb_bit_reader()
+    : m_words(nullptr)
+    , m_bits(0)
+{
+}
+
+inline crb_bit_reader::crb_bit_reader(const std::uint64_t *words)
+    : m_words(words)
+    , m_bits(0)
+{
+}
+
+inline std::uint64_t crb_bit_reader::read(unsigned bits)
+{
+    if (bits == 0)
+        return 0;
+
+    auto word = m_bits / 64;
+    auto offset = unsigned(m_bits % 64);
+
+    std::uint64_t value = m_words[word] >> offset;
+    if (offset + bits > 64)
+        value |= m_words[word + 1] << (64 - offset);
+    m_bits += bits;
+    return value & crb_mask(bits);
+}
+
+// delta-of-delta, zigzagged, with the Gorilla style size classes:
+// 0 -> '0', then '10' + 7 bits, '110' + 9, '1110' + 12, '11110' + 32, '11111' + 64
+
+template<class T>
+void crb_codec<T, false>::encoder::first(T value)
+{
+    m_previous = std::uint64_t(value);
+    m_delta = 0;
+}
+
+template<class T>
+void crb_codec<T, false>::encoder::next(crb_bit_writer &writer, T value)
+{
+    auto delta = std::uint64_t(value) - m_previous;
+    auto dod = delta - m_delta;
+    auto zigzag = (dod << 1) ^ (0 - (dod >> 63));
+    m_previous = std::uint64_t(value);
+    m_delta = delta;
+
+    if (zigzag == 0)
+        writer.write(0, 1);
+    else if (zigzag < (1u << 7))
+    {
+        writer.write(0x1, 2);
+        writer.write(zigzag, 7);
+    }
+    else if (zigzag < (1u << 9))
+    {
+        writer.write(0x3, 3);
+        writer.write(zigzag, 9);
+    }
+    else if (zigzag < (1u << 12))
+    {
+        writer.write(0x7, 4);
+        writer.write(zigzag, 12);
+    }
+    else if (zigzag < (std::uint64_t(1) << 32))
+    {
+        writer.write(0xF, 5);
+        writer.write(zigzag, 32);
+    }
+    else
+    {
+        writer.write(0x1F, 5);
+        writer.write(zigzag, 64);
+    }
+}
+
+template<class T>
+T crb_codec<T, false>::decoder::first(T value)
+{
+    m_previous = std::uint64_t(value);
+    m_delta = 0;
+    return value;
+}
+
+template<class T>
+T crb_codec<T, false>::decoder::next(crb_bit_reader &reader)
+{
+    unsigned ones = 0;
+    while (ones < 5 && reader.read(1))
+        ++ones;
+
+    static const unsigned payload[] = { 0, 7, 9, 12, 32, 64 };
+    auto zigzag = reader.read(payload[ones]);
+    auto dod = (zigzag >> 1) ^ (0 - (zigzag & 1));
+
+    m_delta += dod;
+    m_previous += m_delta;
+    return T(m_previous);
+}
+
+// XOR with the previous value: '0' when equal, '10' + the meaningful bits
+// when they fit the previous window, else '11' + 5 bits of leading zeros
+// + 6 bits of meaningful length - 1 + the meaningful bits
+
+template<class T>
+const unsigned crb_codec<T, true>::width;
+
+template<class T>
+void crb_codec<T, true>::encoder::first(T value)
+{
+    std::memcpy(&m_previous, &value, sizeof(T));
+    m_leading = width + 1;
+    m_trailing = 0;
+}
+
+template<class T>
+void crb_codec<T, true>::encoder::next(crb_bit_writer &writer, T value)
+{
+    bits_type current;
+    std::memcpy(&current, &value, sizeof(T));
+    bits_type difference = current ^ m_previous;
+    m_previous = current;
+
+    if (difference == 0)
+    {
+        writer.write(0, 1);
+        return;
+    }
+
+    auto leading = crb_leading_zeros(difference) - (64 - width);
+    auto trailing = crb_trailing_zeros(difference);
+    if (leading > 31)
+        leading = 31;
+
+    if (m_leading <= width && leading >= m_leading && trailing >= m_trailing)
+    {
+        writer.write(0x1, 2);
+        writer.write(difference >> m_trailing, width - m_leading - m_trailing);
+        return;
+    }
+
+    auto meaningful = width - leading - trailing;
+    writer.write(0x3, 2);
+    writer.write(leading, 5);
+    writer.write(meaningful - 1, 6);
+    writer.write(difference >> trailing, meaningful);
+    m_leading = leading;
+    m_trailing = trailing;
+}
+
+template<class T>
+T crb_codec<T, true>::decoder::first(T value)
+{
+    std::memcpy(&m_previous, &value, sizeof(T));
+    return value;
+}
+
+template<class T>
+T crb_codec<T, true>::decoder::next(crb_bit_reader &reader)
+{
+    if (reader.read(1))
+    {
+        if (reader.read(1))
+        {
+            m_leading = unsigned(reader.read(5));
+            auto meaningful = unsigned(reader.read(6)) + 1;
+            m_trailing = width - m_leading - meaningful;
+        }
+
+        auto meaningful = width - m_leading - m_trailing;
+        m_previous ^= bits_type(reader.read(meaningful) << m_trailing);
+    }
+
+    T value;
+    std::memcpy(&value, &m_previous, sizeof(T));
+    return value;
+}
+
+}
+
+template<class T>
+CRB_COMP_IMP::CompressedRingBuffer(size_type blockCount, size_type blockSize)
+    : m_blocks(blockCount)
+    , m_blockSize(blockSize)
+{
+    if (blockCount == 0 || blockSize == 0)
+        throw std::invalid_argument("compressed ring buffer needs at least one block of one element");
+
+    m_plain.reserve(blockSize);
+}
+
+template<class T>
+T CRB_COMP_IMP::front() const
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    return m_blocks.empty() ? m_plain.front() : m_blocks.front().m_first;
+}
+
+template<class T>
+T CRB_COMP_IMP::back() const
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    if (!m_plain.empty())
+        return m_plain.back();
+
+    auto last = begin();
+    last += size() - 1;
+    return *last;
+}
+
+template<class T>
+void CRB_COMP_IMP::clear()
+{
+    m_blocks.clear();
+    m_plain.clear();
+}
+
+template<class T>
+void CRB_COMP_IMP::push_back(T value)
+{
+    m_plain.push_back(value);
+    if (m_plain.size() == m_blockSize)
+        flush();
+}
+
+template<class T>
+typename CRB_COMP_IMP::size_type CompressedRingBuffer<T>::size() const
+{
+    return m_blocks.size() * m_blockSize + m_plain.size();
+}
+
+template<class T>
+bool CRB_COMP_IMP::empty() const
+{
+    return size() == 0;
+}
+
+template<class T>
+typename CRB_COMP_IMP::size_type CompressedRingBuffer<T>::block_count() const
+{
+    return m_blocks.capacity();
+}
+
+template<class T>
+typename CRB_COMP_IMP::size_type CompressedRingBuffer<T>::block_size() const
+{
+    return m_blockSize;
+}
+
+template<class T>
+typename CRB_COMP_IMP::size_type CompressedRingBuffer<T>::memory_usage() const
+{
+    size_type bytes = m_blocks.capacity() * sizeof(block) + m_plain.capacity() * sizeof(T);
+    for (const auto &stored : m_blocks)
+        bytes += stored.m_words.capacity() * sizeof(std::uint64_t);
+    return bytes;
+}
+
+// iterators
+
+template<class T>
+typename CRB_COMP_IMP::const_iterator CompressedRingBuffer<T>::begin() const
+{
+    return const_iterator(this, m_blocks.empty() ? m_blocks.capacity() : 0);
+}
+
+template<class T>
+typename CRB_COMP_IMP::const_iterator CompressedRingBuffer<T>::end() const
+{
+    auto it = const_iterator(this, m_blocks.capacity());
+    it.m_offset = m_plain.size();
+    return it;
+}
+
+template<class T>
+CRB_COMP_IT_IMP::const_iterator()
+    : m_owner(nullptr)
+    , m_block(0)
+    , m_offset(0)
+    , m_value()
+{
+}
+
+template<class T>
+CRB_COMP_IT_IMP::const_iterator(const CompressedRingBuffer *owner, size_type block)
+    : m_owner(owner)
+    , m_block(block)
+    , m_offset(0)
+    , m_value()
+{
+    load();
+}
+
+template<class T>
+bool CRB_COMP_IT_IMP::operator==(const const_iterator &other) const
+{
+    return m_owner == other.m_owner && m_block == other.m_block && m_offset == other.m_offset;
+}
+
+template<class T>
+bool CRB_COMP_IT_IMP::operator!=(const const_iterator &other) const
+{
+    return !(operator==(other));
+}
+
+template<class T>
+typename CRB_COMP_IMP::const_iterator &CRB_COMP_IT_IMP::operator++()
+{
+    ++m_offset;
+    if (m_block == m_owner->m_blocks.capacity())
+    {
+        if (m_offset < m_owner->m_plain.size())
+            m_value = m_owner->m_plain[m_offset];
+    }
+    else if (m_offset < m_owner->m_blockSize)
+        m_value = m_decoder.next(m_reader);
+    else
+    {
+        ++m_block;
+        if (m_block == m_owner->m_blocks.size())
+            m_block = m_owner->m_blocks.capacity();
+        m_offset = 0;
+        load();
+    }
+    return *this;
+}
+
+template<class T>
+typename CRB_COMP_IMP::const_iterator CRB_COMP_IT_IMP::operator++(int)
+{
+    auto temp = *this;
+    operator++();
+    return temp;
+}
+
+template<class T>
+typename CRB_COMP_IMP::const_iterator &CRB_COMP_IT_IMP::operator+=(size_type pos)
+{
+    auto plain = m_owner->m_blocks.capacity();
+    if (m_block != plain && pos >= m_owner->m_blockSize - m_offset)
+    {
+        pos -= m_owner->m_blockSize - m_offset;
+        m_block += 1 + pos / m_owner->m_blockSize;
+        pos %= m_owner->m_blockSize;
+
+        if (m_block >= m_owner->m_blocks.size())
+        {
+            pos += (m_block - m_owner->m_blocks.size()) * m_owner->m_blockSize;
+            m_block = plain;
+        }
+        m_offset = 0;
+        load();
+    }
+
+    if (m_block == plain)
+    {
+        m_offset += pos;
+        if (m_offset < m_owner->m_plain.size())
+            m_value = m_owner->m_plain[m_offset];
+        return *this;
+    }
+
+    for (; pos; --pos)
+    {
+        ++m_offset;
+        m_value = m_decoder.next(m_reader);
+    }
+    return *this;
+}
+
+template<class T>
+typename CRB_COMP_IMP::const_iterator CRB_COMP_IT_IMP::operator+(size_type pos) const
+{
+    auto temp = *this;
+    temp += pos;
+    return temp;
+}
+
+template<class T>
+const T &CRB_COMP_IT_IMP::operator*() const
+{
+    return m_value;
+}
+
+template<class T>
+const T *CRB_COMP_IT_IMP::operator->() const
+{
+    return &m_value;
+}
+
+template<class T>
+void CRB_COMP_IT_IMP::load()
+{
+    if (m_block == m_owner->m_blocks.capacity())
+    {
+        if (m_offset < m_owner->m_plain.size())
+            m_value = m_owner->m_plain[m_offset];
+        return;
+    }
+
+    const block &current = m_owner->m_blocks[m_block];
+    m_reader = Details::crb_bit_reader(current.m_words.data());
+    m_value = m_decoder.first(current.m_first);
+}
+
+// imps
+
+template<class T>
+void CRB_COMP_IMP::flush()
+{
+    block encoded;
+    encoded.m_words.swap(m_spare);
+    if (m_blocks.size() == m_blocks.capacity())
+        m_spare.swap(m_blocks.front().m_words);
+
+    encoded.m_first = m_plain.front();
+    Details::crb_bit_writer writer(encoded.m_words);
+    typename Details::crb_codec<T>::encoder encoder;
+    encoder.first(m_plain.front());
+    for (size_type pos = 1; pos < m_plain.size(); ++pos)
+        encoder.next(writer, m_plain[pos]);
+
+    m_blocks.push_back(std::move(encoded));
+    m_plain.clear();
+}
+
+#undef CRB_COMP_IMP
+#undef CRB_COMP_IT_IMP
@@ -0,0 +1,87 @@
+//
+//  DedupeRingBuffer.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef DedupeRingBuffer_h
+#define DedupeRingBuffer_h
+
+#include "RingBuffer.h"
+#include <functional>
+#include <vector>
+
+// Set of the last capacity() distinct values, for dropping repeated ids.
+// Values live in a RingBuffer, an open addressing table (linear probing,
+// at most half full) maps them back to their slots by push sequence. Both
+// are allocated up front; insert and contains are O(1) expected, and an
+// insert into a full ring evicts the oldest value from the table as well.
+template
+    <
+        class T
+        , class Hash = std::hash<T>
+        , class KeyEqual = std::equal_to<T>
+        , class Alloc = std::allocator<T>
+    >
+class DedupeRingBuffer
+{
+public:
+    typedef RingBuffer<T, Alloc> buffer_type;
+    typedef typename buffer_type::value_type value_type;
+    typedef typename buffer_type::const_reference const_reference;
+    typedef typename buffer_type::size_type size_type;
+    typedef typename buffer_type::const_iterator const_iterator;
+
+    explicit DedupeRingBuffer
+        (
+            size_type capacity
+            , const Hash &hash = Hash()
+            , const KeyEqual &equal = KeyEqual()
+            , const Alloc &alloc = Alloc()
+        );
+
+    // false when value is already among the recent ones, nothing is changed then
+    bool insert(const T &value);
+    bool contains(const T &value) const;
+
+    const_reference front() const;
+    const_reference back() const;
+    void pop_front();
+    void clear();
+
+    size_type size() const;
+    size_type capacity() const;
+    bool empty() const;
+
+    const buffer_type &buffer() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    static const size_type npos = size_type(-1);
+
+    struct entry
+    {
+        size_type m_sequence;  // push_count of the value, npos when free
+        std::size_t m_hash;
+    };
+
+    const T &value(size_type sequence) const;
+    // slot holding value or npos
+    size_type find(const T &value, std::size_t hash) const;
+    void erase_front();
+
+// data
+private:
+    buffer_type m_buffer;
+    std::vector<entry> m_table;
+    size_type m_mask;
+    Hash m_hash;
+    KeyEqual m_equal;
+};
+
+#include "DedupeRingBuffer.hpp"
+
+#endif /* DedupeRingBuffer_h */
@@ -0,0 +1,169 @@
+#include "DedupeRingBuffer.h"
+#include <stdexcept>
+
+#define DRB_IMP DedupeRingBuffer<T, Hash, KeyEqual, Alloc>
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+const typename DRB_IMP::size_type DRB_IMP::npos;
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+DRB_IMP::DedupeRingBuffer(size_type capacity, const Hash &hash, const KeyEqual &equal, const Alloc &alloc)
+    : m_buffer(capacity, alloc)
+    , m_hash(hash)
+    , m_equal(equal)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("dedupe ring buffer capacity is zero");
+
+    size_type slots = 2;
+    while (slots < 2 * capacity)
+        slots *= 2;
+
+    entry free = { npos, 0 };
+    m_table.assign(slots, free);
+    m_mask = slots - 1;
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+bool DRB_IMP::insert(const T &value)
+{
+    auto hash = m_hash(value);
+    if (find(value, hash) != npos)
+        return false;
+
+    if (m_buffer.size() == m_buffer.capacity())
+        erase_front();
+
+    m_buffer.push_back(value);
+
+    auto pos = hash & m_mask;
+    while (m_table[pos].m_sequence != npos)
+        pos = (pos + 1) & m_mask;
+
+    m_table[pos].m_sequence = m_buffer.push_count() - 1;
+    m_table[pos].m_hash = hash;
+    return true;
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+bool DRB_IMP::contains(const T &value) const
+{
+    return find(value, m_hash(value)) != npos;
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+typename DRB_IMP::const_reference DRB_IMP::front() const
+{
+    return m_buffer.front();
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+typename DRB_IMP::const_reference DRB_IMP::back() const
+{
+    return m_buffer.back();
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+void DRB_IMP::pop_front()
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    erase_front();
+    m_buffer.pop_front();
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+void DRB_IMP::clear()
+{
+    while (!empty())
+        pop_front();
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+typename DRB_IMP::size_type DRB_IMP::size() const
+{
+    return m_buffer.size();
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+typename DRB_IMP::size_type DRB_IMP::capacity() const
+{
+    return m_buffer.capacity();
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+bool DRB_IMP::empty() const
+{
+    return m_buffer.empty();
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+const typename DRB_IMP::buffer_type &DRB_IMP::buffer() const
+{
+    return m_buffer;
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+typename DRB_IMP::const_iterator DRB_IMP::begin() const
+{
+    return m_buffer.begin();
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+typename DRB_IMP::const_iterator DRB_IMP::end() const
+{
+    return m_buffer.end();
+}
+
+// imps
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+const T &DRB_IMP::value(size_type sequence) const
+{
+    auto front_sequence = m_buffer.push_count() - m_buffer.size();
+    return m_buffer[sequence - front_sequence];
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+typename DRB_IMP::size_type DRB_IMP::find(const T &target, std::size_t hash) const
+{
+    for (auto pos = hash & m_mask; m_table[pos].m_sequence != npos; pos = (pos + 1) & m_mask)
+    {
+        if (m_table[pos].m_hash == hash && m_equal(value(m_table[pos].m_sequence), target))
+            return pos;
+    }
+    return npos;
+}
+
+template<class T, class Hash, class KeyEqual, class Alloc>
+void DRB_IMP::erase_front()
+{
+    auto sequence = m_buffer.push_count() - m_buffer.size();
+    auto pos = m_hash(m_buffer.front()) & m_mask;
+    while (m_table[pos].m_sequence != sequence)
+        pos = (pos + 1) & m_mask;
+
+    // backward shift deletion, keeps probe chains intact without tombstones
+    auto next = pos;
+    for (;;)
+    {
+        next = (next + 1) & m_mask;
+        if (m_table[next].m_sequence == npos)
+            break;
+
+        // an entry may fill the hole only if its home slot is not in (pos, next]
+        auto home = m_table[next].m_hash & m_mask;
+        bool between = pos <= next
+            ? pos < home && home <= next
+            : pos < home || home <= next;
+        if (between)
+            continue;
+
+        m_table[pos] = m_table[next];
+        pos = next;
+    }
+    m_table[pos].m_sequence = npos;
+}
+
+#undef DRB_IMP
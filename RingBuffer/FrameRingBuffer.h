@@ -0,0 +1,85 @@
+//
+//  FrameRingBuffer.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef FrameRingBuffer_h
+#define FrameRingBuffer_h
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Ring of interleaved multi-channel frames over one sample array, with the
+// channel count chosen at run time. Besides raw interleaved push and pop it
+// converts from and to per-channel float arrays (planar), applying a gain
+// and the int16/int32 full scale on the way. The conversion kernels run
+// straight on the ring storage, one pass per contiguous part around the
+// storage end, and write into the caller's arrays. With SSE2 every four
+// channels of four frames are converted together and transposed in
+// registers; leftover channels and frames take the scalar path.
+// Float to integer conversion saturates and rounds to nearest.
+template<class Sample>
+class FrameRingBuffer
+{
+    static_assert
+        (
+            std::is_same<Sample, std::int16_t>::value
+            || std::is_same<Sample, std::int32_t>::value
+            || std::is_same<Sample, float>::value
+            , "frame ring buffer samples are int16_t, int32_t or float"
+        );
+
+public:
+    typedef Sample sample_type;
+    typedef std::size_t size_type;
+
+    // capacity in frames
+    FrameRingBuffer(size_type capacity, size_type channels);
+
+    size_type channels() const;
+    // in frames
+    size_type size() const;
+    size_type capacity() const;
+    bool empty() const;
+    void clear();
+
+    // the oldest frames are overwritten when the new ones don't fit
+    void push_frames(const Sample *interleaved, size_type frames);
+    // channels[c][i] * gain is sample c of frame i
+    void push_frames(const float *const *channels, size_type frames, float gain = 1.0f);
+
+    // return how many frames were popped
+    size_type pop_frames(Sample *interleaved, size_type frames);
+    // channels[c][i] becomes sample c of the i-th oldest frame times gain
+    size_type pop_frames(float *const *channels, size_type frames, float gain = 1.0f);
+
+    // samples of the frame pos, oldest first
+    const Sample *frame(size_type pos) const;
+
+    // contiguous parts of the content, in frames: frames_one is the older
+    // one, frames_two is empty unless the content wraps around the storage end
+    std::pair<const Sample *, size_type> frames_one() const;
+    std::pair<const Sample *, size_type> frames_two() const;
+
+private:
+    // makes room for frames at the end, returns how many of the leading
+    // input frames are skipped because they don't fit at all
+    size_type reserve_back(size_type &frames);
+
+// data
+private:
+    std::vector<Sample> m_samples;
+    size_type m_channels;
+    size_type m_capacity;
+    size_type m_start;
+    size_type m_size;
+};
+
+#include "FrameRingBuffer.hpp"
+
+#endif /* FrameRingBuffer_h */
@@ -0,0 +1,386 @@
+#include "FrameRingBuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FRB_HAS_SSE2 1
+#endif
+
+#define FRB_IMP FrameRingBuffer<Sample>
+
+namespace Details {
+
+// float full scale and saturation bounds of the sample formats
+template<class Sample>
+struct frb_sample_traits;
+
+template<>
+struct frb_sample_traits<std::int16_t>
+{
+    static float full_scale() { return 32768.0f; }
+    static float lowest() { return -32768.0f; }
+    static float highest() { return 32767.0f; }
+};
+
+template<>
+struct frb_sample_traits<std::int32_t>
+{
+    static float full_scale() { return 2147483648.0f; }
+    static float lowest() { return -2147483648.0f; }
+    // largest float below 2^31
+    static float highest() { return 2147483520.0f; }
+};
+
+template<>
+struct frb_sample_traits<float>
+{
+    static float full_scale() { return 1.0f; }
+};
+
+// scalar conversions, scale folds the gain and the full scale
+
+template<class Sample>
+inline float frb_to_float(Sample value, float scale)
+{
+    return float(value) * scale;
+}
+
+template<class Sample>
+inline Sample frb_from_float(float value, float scale)
+{
+    typedef frb_sample_traits<Sample> traits;
+    value = std::min(std::max(value * scale, traits::lowest()), traits::highest());
+    return Sample(std::lrint(value));
+}
+
+template<>
+inline float frb_from_float<float>(float value, float scale)
+{
+    return value * scale;
+}
+
+#ifdef FRB_HAS_SSE2
+
+// four consecutive samples from and to four floats
+
+template<class Sample>
+__m128 frb_load4(const Sample *from);
+
+template<>
+inline __m128 frb_load4<std::int16_t>(const std::int16_t *from)
+{
+    __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(from));
+    // sign extends to 32 bits
+    __m128i wide = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+    return _mm_cvtepi32_ps(wide);
+}
+
+template<>
+inline __m128 frb_load4<std::int32_t>(const std::int32_t *from)
+{
+    return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(from)));
+}
+
+template<>
+inline __m128 frb_load4<float>(const float *from)
+{
+    return _mm_loadu_ps(from);
+}
+
+template<class Sample>
+void frb_store4(Sample *to, __m128 values);
+
+template<>
+inline void frb_store4<std::int16_t>(std::int16_t *to, __m128 values)
+{
+    typedef frb_sample_traits<std::int16_t> traits;
+    values = _mm_min_ps(_mm_max_ps(values, _mm_set1_ps(traits::lowest())), _mm_set1_ps(traits::highest()));
+    __m128i wide = _mm_cvtps_epi32(values);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(to), _mm_packs_epi32(wide, wide));
+}
+
+template<>
+inline void frb_store4<std::int32_t>(std::int32_t *to, __m128 values)
+{
+    typedef frb_sample_traits<std::int32_t> traits;
+    values = _mm_min_ps(_mm_max_ps(values, _mm_set1_ps(traits::lowest())), _mm_set1_ps(traits::highest()));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(to), _mm_cvtps_epi32(values));
+}
+
+template<>
+inline void frb_store4<float>(float *to, __m128 values)
+{
+    _mm_storeu_ps(to, values);
+}
+
+#endif
+
+// interleaved frames to planar floats, out[c] + offset receives channel c
+template<class Sample>
+void frb_deinterleave(const Sample *in, std::size_t channels, std::size_t frames, float *const *out, std::size_t offset, float scale)
+{
+    std::size_t frame = 0;
+    std::size_t channel = 0;
+
+#ifdef FRB_HAS_SSE2
+    __m128 factor = _mm_set1_ps(scale);
+    std::size_t simdFrames = frames & ~std::size_t(3);
+
+    if (channels == 1)
+    {
+        for (; frame < simdFrames; frame += 4)
+            _mm_storeu_ps(out[0] + offset + frame, _mm_mul_ps(frb_load4(in + frame), factor));
+        channel = 1;
+    }
+    else if (channels == 2)
+    {
+        for (; frame < simdFrames; frame += 4)
+        {
+            __m128 first = _mm_mul_ps(frb_load4(in + 2 * frame), factor);
+            __m128 second = _mm_mul_ps(frb_load4(in + 2 * frame + 4), factor);
+            _mm_storeu_ps(out[0] + offset + frame, _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(out[1] + offset + frame, _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+        channel = 2;
+    }
+    else
+    {
+        for (; channel + 4 <= channels; channel += 4)
+        {
+            for (frame = 0; frame < simdFrames; frame += 4)
+            {
+                const Sample *from = in + frame * channels + channel;
+                __m128 row0 = _mm_mul_ps(frb_load4(from), factor);
+                __m128 row1 = _mm_mul_ps(frb_load4(from + channels), factor);
+                __m128 row2 = _mm_mul_ps(frb_load4(from + 2 * channels), factor);
+                __m128 row3 = _mm_mul_ps(frb_load4(from + 3 * channels), factor);
+                _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+                _mm_storeu_ps(out[channel] + offset + frame, row0);
+                _mm_storeu_ps(out[channel + 1] + offset + frame, row1);
+                _mm_storeu_ps(out[channel + 2] + offset + frame, row2);
+                _mm_storeu_ps(out[channel + 3] + offset + frame, row3);
+            }
+        }
+    }
+
+    // frames left over by the vector loops, for the channels they covered
+    for (std::size_t done = 0; done < channel; ++done)
+    {
+        for (std::size_t rest = simdFrames; rest < frames; ++rest)
+            out[done][offset + rest] = frb_to_float(in[rest * channels + done], scale);
+    }
+#endif
+
+    for (; channel < channels; ++channel)
+    {
+        for (frame = 0; frame < frames; ++frame)
+            out[channel][offset + frame] = frb_to_float(in[frame * channels + channel], scale);
+    }
+}
+
+// planar floats to interleaved frames, in[c] + offset holds channel c
+template<class Sample>
+void frb_interleave(const float *const *in, std::size_t offset, std::size_t channels, std::size_t frames, Sample *out, float scale)
+{
+    std::size_t frame = 0;
+    std::size_t channel = 0;
+
+#ifdef FRB_HAS_SSE2
+    __m128 factor = _mm_set1_ps(scale);
+    std::size_t simdFrames = frames & ~std::size_t(3);
+
+    if (channels == 1)
+    {
+        for (; frame < simdFrames; frame += 4)
+            frb_store4(out + frame, _mm_mul_ps(_mm_loadu_ps(in[0] + offset + frame), factor));
+        channel = 1;
+    }
+    else if (channels == 2)
+    {
+        for (; frame < simdFrames; frame += 4)
+        {
+            __m128 left = _mm_mul_ps(_mm_loadu_ps(in[0] + offset + frame), factor);
+            __m128 right = _mm_mul_ps(_mm_loadu_ps(in[1] + offset + frame), factor);
+            frb_store4(out + 2 * frame, _mm_unpacklo_ps(left, right));
+            frb_store4(out + 2 * frame + 4, _mm_unpackhi_ps(left, right));
+        }
+        channel = 2;
+    }
+    else
+    {
+        for (; channel + 4 <= channels; channel += 4)
+        {
+            for (frame = 0; frame < simdFrames; frame += 4)
+            {
+                __m128 row0 = _mm_mul_ps(_mm_loadu_ps(in[channel] + offset + frame), factor);
+                __m128 row1 = _mm_mul_ps(_mm_loadu_ps(in[channel + 1] + offset + frame), factor);
+                __m128 row2 = _mm_mul_ps(_mm_loadu_ps(in[channel + 2] + offset + frame), factor);
+                __m128 row3 = _mm_mul_ps(_mm_loadu_ps(in[channel + 3] + offset + frame), factor);
+                _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+                Sample *to = out + frame * channels + channel;
+                frb_store4(to, row0);
+                frb_store4(to + channels, row1);
+                frb_store4(to + 2 * channels, row2);
+                frb_store4(to + 3 * channels, row3);
+            }
+        }
+    }
+
+    for (std::size_t done = 0; done < channel; ++done)
+    {
+        for (std::size_t rest = simdFrames; rest < frames; ++rest)
+            out[rest * channels + done] = frb_from_float<Sample>(in[done][offset + rest], scale);
+    }
+#endif
+
+    for (; channel < channels; ++channel)
+    {
+        for (frame = 0; frame < frames; ++frame)
+            out[frame * channels + channel] = frb_from_float<Sample>(in[channel][offset + frame], scale);
+    }
+}
+
+}
+
+template<class Sample>
+FRB_IMP::FrameRingBuffer(size_type capacity, size_type channels)
+    : m_channels(channels)
+    , m_capacity(capacity)
+    , m_start(0)
+    , m_size(0)
+{
+    if (capacity == 0 || channels == 0)
+        throw std::invalid_argument("frame ring buffer needs at least one frame of one channel");
+
+    m_samples.resize(capacity * channels);
+}
+
+template<class Sample>
+typename FRB_IMP::size_type FrameRingBuffer<Sample>::channels() const
+{
+    return m_channels;
+}
+
+template<class Sample>
+typename FRB_IMP::size_type FrameRingBuffer<Sample>::size() const
+{
+    return m_size;
+}
+
+template<class Sample>
+typename FRB_IMP::size_type FrameRingBuffer<Sample>::capacity() const
+{
+    return m_capacity;
+}
+
+template<class Sample>
+bool FRB_IMP::empty() const
+{
+    return m_size == 0;
+}
+
+template<class Sample>
+void FRB_IMP::clear()
+{
+    m_start = 0;
+    m_size = 0;
+}
+
+template<class Sample>
+void FRB_IMP::push_frames(const Sample *interleaved, size_type frames)
+{
+    interleaved += reserve_back(frames) * m_channels;
+
+    auto end = (m_start + m_size) % m_capacity;
+    auto first = std::min(frames, m_capacity - end);
+    std::memcpy(m_samples.data() + end * m_channels, interleaved, first * m_channels * sizeof(Sample));
+    std::memcpy(m_samples.data(), interleaved + first * m_channels, (frames - first) * m_channels * sizeof(Sample));
+    m_size += frames;
+}
+
+template<class Sample>
+void FRB_IMP::push_frames(const float *const *channels, size_type frames, float gain)
+{
+    auto skipped = reserve_back(frames);
+    auto scale = gain * Details::frb_sample_traits<Sample>::full_scale();
+
+    auto end = (m_start + m_size) % m_capacity;
+    auto first = std::min(frames, m_capacity - end);
+    Details::frb_interleave(channels, skipped, m_channels, first, m_samples.data() + end * m_channels, scale);
+    Details::frb_interleave(channels, skipped + first, m_channels, frames - first, m_samples.data(), scale);
+    m_size += frames;
+}
+
+template<class Sample>
+typename FRB_IMP::size_type FrameRingBuffer<Sample>::pop_frames(Sample *interleaved, size_type frames)
+{
+    frames = std::min(frames, m_size);
+    auto first = std::min(frames, m_capacity - m_start);
+    std::memcpy(interleaved, m_samples.data() + m_start * m_channels, first * m_channels * sizeof(Sample));
+    std::memcpy(interleaved + first * m_channels, m_samples.data(), (frames - first) * m_channels * sizeof(Sample));
+
+    m_start = (m_start + frames) % m_capacity;
+    m_size -= frames;
+    return frames;
+}
+
+template<class Sample>
+typename FRB_IMP::size_type FrameRingBuffer<Sample>::pop_frames(float *const *channels, size_type frames, float gain)
+{
+    auto scale = gain / Details::frb_sample_traits<Sample>::full_scale();
+
+    frames = std::min(frames, m_size);
+    auto first = std::min(frames, m_capacity - m_start);
+    Details::frb_deinterleave(m_samples.data() + m_start * m_channels, m_channels, first, channels, 0, scale);
+    Details::frb_deinterleave(m_samples.data(), m_channels, frames - first, channels, first, scale);
+
+    m_start = (m_start + frames) % m_capacity;
+    m_size -= frames;
+    return frames;
+}
+
+template<class Sample>
+const Sample *FRB_IMP::frame(size_type pos) const
+{
+    return m_samples.data() + (m_start + pos) % m_capacity * m_channels;
+}
+
+template<class Sample>
+std::pair<const Sample *, typename FRB_IMP::size_type> FrameRingBuffer<Sample>::frames_one() const
+{
+    auto first = std::min(m_size, m_capacity - m_start);
+    return std::pair<const Sample *, size_type>(m_samples.data() + m_start * m_channels, first);
+}
+
+template<class Sample>
+std::pair<const Sample *, typename FRB_IMP::size_type> FrameRingBuffer<Sample>::frames_two() const
+{
+    auto first = std::min(m_size, m_capacity - m_start);
+    return std::pair<const Sample *, size_type>(m_samples.data(), m_size - first);
+}
+
+// imps
+
+template<class Sample>
+typename FRB_IMP::size_type FrameRingBuffer<Sample>::reserve_back(size_type &frames)
+{
+    size_type skipped = 0;
+    if (frames > m_capacity)
+    {
+        skipped = frames - m_capacity;
+        frames = m_capacity;
+    }
+
+    if (m_size + frames > m_capacity)
+    {
+        auto dropped = m_size + frames - m_capacity;
+        m_start = (m_start + dropped) % m_capacity;
+        m_size -= dropped;
+    }
+    return skipped;
+}
+
+#undef FRB_IMP
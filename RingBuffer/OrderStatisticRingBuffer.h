@@ -0,0 +1,106 @@
+//
+//  OrderStatisticRingBuffer.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef OrderStatisticRingBuffer_h
+#define OrderStatisticRingBuffer_h
+
+#include "RingBuffer.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// RingBuffer with a sorted index over its window, for rolling medians and
+// percentiles. The index is a treap with subtree sizes whose nodes are
+// preallocated one per slot, so push_back, pop_front and the eviction done
+// by pushing into a full ring cost O(log N) expected and never allocate.
+// Order queries are O(log N) expected.
+template
+    <
+        class T
+        , class Compare = std::less<T>
+        , class Alloc = std::allocator<T>
+    >
+class OrderStatisticRingBuffer
+{
+public:
+    typedef RingBuffer<T, Alloc> buffer_type;
+    typedef typename buffer_type::value_type value_type;
+    typedef typename buffer_type::const_reference const_reference;
+    typedef typename buffer_type::size_type size_type;
+    typedef typename buffer_type::const_iterator const_iterator;
+
+    explicit OrderStatisticRingBuffer
+        (
+            size_type capacity
+            , const Compare &compare = Compare()
+            , const Alloc &alloc = Alloc()
+        );
+
+    const_reference front() const;
+    const_reference back() const;
+    const_reference operator[](size_type) const;
+
+    void clear();
+    void push_back(const T&);
+    void pop_front();
+
+    size_type size() const;
+    size_type capacity() const;
+    bool empty() const;
+
+    // k-th smallest element of the window, 0 based
+    const_reference nth_smallest(size_type k) const;
+    // nearest rank quantile, q in [0, 1]
+    const_reference quantile(double q) const;
+    // lower median
+    const_reference median() const;
+    // number of elements less than value
+    size_type rank(const T &value) const;
+
+    const buffer_type &buffer() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    static const size_type npos = size_type(-1);
+
+    struct node
+    {
+        size_type m_left;
+        size_type m_right;
+        size_type m_count;
+        size_type m_sequence;  // push_count of the element it indexes
+        std::uint32_t m_priority;
+    };
+
+    const T &value(size_type index) const;
+    // orders by value, then by push sequence, so every key is unique
+    bool less(size_type left, size_type right) const;
+    size_type count(size_type index) const;
+    void update(size_type index);
+
+    void split(size_type root, size_type key, size_type &left, size_type &right);
+    size_type merge(size_type left, size_type right);
+    size_type insert(size_type root, size_type index);
+    size_type erase(size_type root, size_type index);
+
+    void index_back();
+    void unindex_front();
+
+// data
+private:
+    buffer_type m_buffer;
+    Compare m_compare;
+    std::vector<node> m_nodes;
+    size_type m_root;
+    std::uint32_t m_random;
+};
+
+#include "OrderStatisticRingBuffer.hpp"
+
+#endif /* OrderStatisticRingBuffer_h */
@@ -0,0 +1,303 @@
+#include "OrderStatisticRingBuffer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+#define OSRB_IMP OrderStatisticRingBuffer<T, Compare, Alloc>
+
+template<class T, class Compare, class Alloc>
+const typename OSRB_IMP::size_type OSRB_IMP::npos;
+
+template<class T, class Compare, class Alloc>
+OSRB_IMP::OrderStatisticRingBuffer(size_type capacity, const Compare &compare, const Alloc &alloc)
+    : m_buffer(capacity, alloc)
+    , m_compare(compare)
+    , m_nodes(capacity)
+    , m_root(npos)
+    , m_random(0x9E3779B9u)
+{
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::const_reference OSRB_IMP::front() const
+{
+    return m_buffer.front();
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::const_reference OSRB_IMP::back() const
+{
+    return m_buffer.back();
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::const_reference OSRB_IMP::operator[](size_type pos) const
+{
+    return m_buffer[pos];
+}
+
+template<class T, class Compare, class Alloc>
+void OSRB_IMP::clear()
+{
+    m_buffer.clear();
+    m_root = npos;
+}
+
+template<class T, class Compare, class Alloc>
+void OSRB_IMP::push_back(const T &value)
+{
+    // the oldest element is overwritten, drop it from the index while it is still there
+    if (m_buffer.size() == m_buffer.capacity() && !m_buffer.empty())
+        unindex_front();
+
+    m_buffer.push_back(value);
+    index_back();
+}
+
+template<class T, class Compare, class Alloc>
+void OSRB_IMP::pop_front()
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    unindex_front();
+    m_buffer.pop_front();
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::size_type OSRB_IMP::size() const
+{
+    return m_buffer.size();
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::size_type OSRB_IMP::capacity() const
+{
+    return m_buffer.capacity();
+}
+
+template<class T, class Compare, class Alloc>
+bool OSRB_IMP::empty() const
+{
+    return m_buffer.empty();
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::const_reference OSRB_IMP::nth_smallest(size_type k) const
+{
+    if (k >= size())
+        throw std::range_error("order statistic out of range");
+
+    auto current = m_root;
+    for (;;)
+    {
+        auto left = count(m_nodes[current].m_left);
+        if (k < left)
+            current = m_nodes[current].m_left;
+        else if (k == left)
+            return value(current);
+        else
+        {
+            k -= left + 1;
+            current = m_nodes[current].m_right;
+        }
+    }
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::const_reference OSRB_IMP::quantile(double q) const
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    double rank = std::ceil(q * size());
+    size_type k = rank <= 1.0 ? 0 : size_type(rank) - 1;
+    return nth_smallest(std::min(k, size() - 1));
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::const_reference OSRB_IMP::median() const
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    return nth_smallest((size() - 1) / 2);
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::size_type OSRB_IMP::rank(const T &target) const
+{
+    size_type result = 0;
+    auto current = m_root;
+    while (current != npos)
+    {
+        if (m_compare(value(current), target))
+        {
+            result += count(m_nodes[current].m_left) + 1;
+            current = m_nodes[current].m_right;
+        }
+        else
+            current = m_nodes[current].m_left;
+    }
+    return result;
+}
+
+template<class T, class Compare, class Alloc>
+const typename OSRB_IMP::buffer_type &OSRB_IMP::buffer() const
+{
+    return m_buffer;
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::const_iterator OSRB_IMP::begin() const
+{
+    return m_buffer.begin();
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::const_iterator OSRB_IMP::end() const
+{
+    return m_buffer.end();
+}
+
+// treap
+
+template<class T, class Compare, class Alloc>
+const T &OSRB_IMP::value(size_type index) const
+{
+    auto front_sequence = m_buffer.push_count() - m_buffer.size();
+    return m_buffer[m_nodes[index].m_sequence - front_sequence];
+}
+
+template<class T, class Compare, class Alloc>
+bool OSRB_IMP::less(size_type left, size_type right) const
+{
+    const T &left_value = value(left);
+    const T &right_value = value(right);
+    if (m_compare(left_value, right_value))
+        return true;
+    if (m_compare(right_value, left_value))
+        return false;
+    return m_nodes[left].m_sequence < m_nodes[right].m_sequence;
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::size_type OSRB_IMP::count(size_type index) const
+{
+    return index == npos ? 0 : m_nodes[index].m_count;
+}
+
+template<class T, class Compare, class Alloc>
+void OSRB_IMP::update(size_type index)
+{
+    m_nodes[index].m_count = count(m_nodes[index].m_left) + count(m_nodes[index].m_right) + 1;
+}
+
+template<class T, class Compare, class Alloc>
+void OSRB_IMP::split(size_type root, size_type key, size_type &left, size_type &right)
+{
+    if (root == npos)
+    {
+        left = right = npos;
+        return;
+    }
+
+    if (less(root, key))
+    {
+        split(m_nodes[root].m_right, key, m_nodes[root].m_right, right);
+        left = root;
+    }
+    else
+    {
+        split(m_nodes[root].m_left, key, left, m_nodes[root].m_left);
+        right = root;
+    }
+    update(root);
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::size_type OSRB_IMP::merge(size_type left, size_type right)
+{
+    if (left == npos)
+        return right;
+    if (right == npos)
+        return left;
+
+    if (m_nodes[left].m_priority > m_nodes[right].m_priority)
+    {
+        m_nodes[left].m_right = merge(m_nodes[left].m_right, right);
+        update(left);
+        return left;
+    }
+
+    m_nodes[right].m_left = merge(left, m_nodes[right].m_left);
+    update(right);
+    return right;
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::size_type OSRB_IMP::insert(size_type root, size_type index)
+{
+    if (root == npos)
+        return index;
+
+    if (m_nodes[index].m_priority > m_nodes[root].m_priority)
+    {
+        split(root, index, m_nodes[index].m_left, m_nodes[index].m_right);
+        update(index);
+        return index;
+    }
+
+    if (less(index, root))
+        m_nodes[root].m_left = insert(m_nodes[root].m_left, index);
+    else
+        m_nodes[root].m_right = insert(m_nodes[root].m_right, index);
+    update(root);
+    return root;
+}
+
+template<class T, class Compare, class Alloc>
+typename OSRB_IMP::size_type OSRB_IMP::erase(size_type root, size_type index)
+{
+    assert(root != npos);
+    if (root == index)
+        return merge(m_nodes[root].m_left, m_nodes[root].m_right);
+
+    if (less(index, root))
+        m_nodes[root].m_left = erase(m_nodes[root].m_left, index);
+    else
+        m_nodes[root].m_right = erase(m_nodes[root].m_right, index);
+    update(root);
+    return root;
+}
+
+template<class T, class Compare, class Alloc>
+void OSRB_IMP::index_back()
+{
+    auto sequence = m_buffer.push_count() - 1;
+    auto index = sequence % m_nodes.size();
+
+    // xorshift32
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+
+    node &added = m_nodes[index];
+    added.m_left = npos;
+    added.m_right = npos;
+    added.m_count = 1;
+    added.m_sequence = sequence;
+    added.m_priority = m_random;
+
+    m_root = insert(m_root, index);
+}
+
+template<class T, class Compare, class Alloc>
+void OSRB_IMP::unindex_front()
+{
+    auto sequence = m_buffer.push_count() - m_buffer.size();
+    m_root = erase(m_root, sequence % m_nodes.size());
+}
+
+#undef OSRB_IMP
@@ -0,0 +1,103 @@
+//
+//  PriorityRingBuffer.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef PriorityRingBuffer_h
+#define PriorityRingBuffer_h
+
+#include "RingBuffer.h"
+#include <cstdint>
+#include <vector>
+
+// Up to 64 prioritized lanes, each a RingBuffer of its own, drained through
+// one consumer interface. Lane 0 has the highest priority. A bitmap of the
+// non-empty lanes makes picking the next lane O(1), so a few urgent
+// elements are never scanned past thousands of bulk ones.
+// strict drains the highest priority non-empty lane first; weighted is a
+// deficit round robin where each visit may take up to weight(lane)
+// elements of a lane, with an unfinished quantum carried into the next pop.
+// What happens on push into a full lane is set per lane.
+template<class T, class Alloc = std::allocator<T>>
+class PriorityRingBuffer
+{
+public:
+    typedef RingBuffer<T, Alloc> lane_type;
+    typedef typename lane_type::value_type value_type;
+    typedef typename lane_type::size_type size_type;
+
+    enum class overflow
+    {
+        overwrite        // the oldest element of the lane is dropped
+        , reject         // the new element is dropped, push returns false
+        , throw_error    // std::overflow_error, nothing changes
+    };
+
+    enum class schedule
+    {
+        strict
+        , weighted
+    };
+
+    enum { max_lanes = 64 };
+
+    // one lane per capacity, all overwriting with weight 1
+    explicit PriorityRingBuffer(const std::vector<size_type> &capacities, const Alloc &alloc = Alloc());
+    PriorityRingBuffer(size_type lanes, size_type capacity, const Alloc &alloc = Alloc());
+
+    void set_overflow(size_type lane, overflow policy);
+    overflow get_overflow(size_type lane) const;
+    // elements taken from the lane per round robin visit, at least 1
+    void set_weight(size_type lane, size_type weight);
+    size_type weight(size_type lane) const;
+    void set_schedule(schedule mode);
+    schedule get_schedule() const;
+
+    // false when the lane rejected the element
+    bool push_back(size_type lane, const T &value);
+    bool push_back(size_type lane, T &&value);
+
+    // false when every lane is empty
+    bool pop_front(T &value);
+    // moves up to count elements to out in scheduling order, returns how many
+    template<class OutputIt>
+    size_type pop_batch(size_type count, OutputIt out);
+
+    void clear();
+    size_type lanes() const;
+    size_type size() const;
+    bool empty() const;
+    const lane_type &lane(size_type lane) const;
+    // elements lost to overwrite or reject in the lane
+    size_type dropped(size_type lane) const;
+
+private:
+    struct lane_state
+    {
+        overflow m_overflow;
+        size_type m_weight;
+        size_type m_deficit;
+        size_type m_dropped;
+    };
+
+    // false when the element must not be pushed
+    bool make_room(size_type lane);
+    void mark(size_type lane);
+    size_type next_lane() const;
+
+// data
+private:
+    std::vector<lane_type> m_lanes;
+    std::vector<lane_state> m_states;
+    std::uint64_t m_nonEmpty;
+    size_type m_cursor;
+    size_type m_size;
+    schedule m_schedule;
+};
+
+#include "PriorityRingBuffer.hpp"
+
+#endif /* PriorityRingBuffer_h */
@@ -0,0 +1,249 @@
+#include "PriorityRingBuffer.h"
+#include <algorithm>
+#include <stdexcept>
+
+#define PRB_IMP PriorityRingBuffer<T, Alloc>
+
+namespace Details {
+
+inline unsigned prb_lowest_bit(std::uint64_t bits)
+{
+#if defined(__GNUC__)
+    return unsigned(__builtin_ctzll(bits));
+#else
+    unsigned index = 0;
+    for (; !(bits & 1); bits >>= 1)
+        ++index;
+    return index;
+#endif
+}
+
+}
+
+template<class T, class Alloc>
+PRB_IMP::PriorityRingBuffer(const std::vector<size_type> &capacities, const Alloc &alloc)
+    : m_nonEmpty(0)
+    , m_cursor(0)
+    , m_size(0)
+    , m_schedule(schedule::strict)
+{
+    if (capacities.empty() || capacities.size() > max_lanes)
+        throw std::invalid_argument("priority ring buffer needs 1 to 64 lanes");
+
+    m_lanes.reserve(capacities.size());
+    for (auto capacity : capacities)
+        m_lanes.emplace_back(capacity, alloc);
+
+    lane_state initial = { overflow::overwrite, 1, 0, 0 };
+    m_states.assign(capacities.size(), initial);
+}
+
+template<class T, class Alloc>
+PRB_IMP::PriorityRingBuffer(size_type lanes, size_type capacity, const Alloc &alloc)
+    : PriorityRingBuffer(std::vector<size_type>(lanes, capacity), alloc)
+{
+}
+
+template<class T, class Alloc>
+void PRB_IMP::set_overflow(size_type lane, overflow policy)
+{
+    m_states.at(lane).m_overflow = policy;
+}
+
+template<class T, class Alloc>
+typename PRB_IMP::overflow PRB_IMP::get_overflow(size_type lane) const
+{
+    return m_states.at(lane).m_overflow;
+}
+
+template<class T, class Alloc>
+void PRB_IMP::set_weight(size_type lane, size_type weight)
+{
+    m_states.at(lane).m_weight = std::max<size_type>(weight, 1);
+}
+
+template<class T, class Alloc>
+typename PRB_IMP::size_type PRB_IMP::weight(size_type lane) const
+{
+    return m_states.at(lane).m_weight;
+}
+
+template<class T, class Alloc>
+void PRB_IMP::set_schedule(schedule mode)
+{
+    m_schedule = mode;
+}
+
+template<class T, class Alloc>
+typename PRB_IMP::schedule PRB_IMP::get_schedule() const
+{
+    return m_schedule;
+}
+
+template<class T, class Alloc>
+bool PRB_IMP::push_back(size_type lane, const T &value)
+{
+    if (!make_room(lane))
+        return false;
+
+    m_lanes[lane].push_back(value);
+    mark(lane);
+    return true;
+}
+
+template<class T, class Alloc>
+bool PRB_IMP::push_back(size_type lane, T &&value)
+{
+    if (!make_room(lane))
+        return false;
+
+    m_lanes[lane].push_back(std::move(value));
+    mark(lane);
+    return true;
+}
+
+template<class T, class Alloc>
+bool PRB_IMP::pop_front(T &value)
+{
+    return pop_batch(1, &value) == 1;
+}
+
+template<class T, class Alloc>
+template<class OutputIt>
+typename PRB_IMP::size_type PRB_IMP::pop_batch(size_type count, OutputIt out)
+{
+    size_type popped = 0;
+    while (popped < count && m_nonEmpty)
+    {
+        auto index = m_schedule == schedule::strict
+            ? size_type(Details::prb_lowest_bit(m_nonEmpty))
+            : next_lane();
+        lane_type &current = m_lanes[index];
+        lane_state &state = m_states[index];
+
+        auto take = std::min(count - popped, current.size());
+        if (m_schedule == schedule::weighted)
+        {
+            // stay on this lane until its quantum is spent, across pops too
+            m_cursor = index;
+            if (state.m_deficit == 0)
+                state.m_deficit = state.m_weight;
+            take = std::min(take, state.m_deficit);
+            state.m_deficit -= take;
+        }
+
+        for (size_type pos = 0; pos < take; ++pos, ++out)
+        {
+            *out = std::move(current.front());
+            current.pop_front();
+        }
+        popped += take;
+        m_size -= take;
+
+        if (current.empty())
+        {
+            m_nonEmpty &= ~(std::uint64_t(1) << index);
+            // an idle lane doesn't save up its quantum
+            state.m_deficit = 0;
+        }
+
+        // the visit is over once the quantum is spent or the lane ran dry
+        if (m_schedule == schedule::weighted && state.m_deficit == 0)
+            m_cursor = (index + 1) % m_lanes.size();
+    }
+    return popped;
+}
+
+template<class T, class Alloc>
+void PRB_IMP::clear()
+{
+    for (size_type lane = 0; lane < m_lanes.size(); ++lane)
+    {
+        m_lanes[lane].clear();
+        m_states[lane].m_deficit = 0;
+    }
+    m_nonEmpty = 0;
+    m_cursor = 0;
+    m_size = 0;
+}
+
+template<class T, class Alloc>
+typename PRB_IMP::size_type PRB_IMP::lanes() const
+{
+    return m_lanes.size();
+}
+
+template<class T, class Alloc>
+typename PRB_IMP::size_type PRB_IMP::size() const
+{
+    return m_size;
+}
+
+template<class T, class Alloc>
+bool PRB_IMP::empty() const
+{
+    return m_size == 0;
+}
+
+template<class T, class Alloc>
+const typename PRB_IMP::lane_type &PRB_IMP::lane(size_type lane) const
+{
+    return m_lanes.at(lane);
+}
+
+template<class T, class Alloc>
+typename PRB_IMP::size_type PRB_IMP::dropped(size_type lane) const
+{
+    return m_states.at(lane).m_dropped;
+}
+
+// imps
+
+template<class T, class Alloc>
+bool PRB_IMP::make_room(size_type lane)
+{
+    lane_type &current = m_lanes.at(lane);
+    if (current.size() < current.capacity())
+        return true;
+
+    lane_state &state = m_states[lane];
+    switch (state.m_overflow)
+    {
+        case overflow::throw_error:
+            throw std::overflow_error("priority ring buffer lane is full");
+        case overflow::reject:
+            ++state.m_dropped;
+            return false;
+        case overflow::overwrite:
+            break;
+    }
+
+    // a lane without storage has nothing to overwrite
+    if (current.capacity() == 0)
+    {
+        ++state.m_dropped;
+        return false;
+    }
+
+    ++state.m_dropped;
+    current.pop_front();
+    --m_size;
+    return true;
+}
+
+template<class T, class Alloc>
+void PRB_IMP::mark(size_type lane)
+{
+    m_nonEmpty |= std::uint64_t(1) << lane;
+    ++m_size;
+}
+
+template<class T, class Alloc>
+typename PRB_IMP::size_type PRB_IMP::next_lane() const
+{
+    // first non-empty lane at or after the cursor, wrapping around
+    auto ahead = m_nonEmpty & (~std::uint64_t(0) << m_cursor);
+    return Details::prb_lowest_bit(ahead ? ahead : m_nonEmpty);
+}
+
+#undef PRB_IMP
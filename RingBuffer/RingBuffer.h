@@ -11,6 +11,7 @@
 
 #include <memory>
 #include <type_traits>
+#include <utility>
 
 template<class T, class Alloc = std::allocator<T>>
 class RingBuffer;
@@ -41,6 +42,20 @@ template
         , bool move = std::is_move_assignable<T>::value
     >
     struct rb_help_push_back_move_full_imp;    
+
+template<class T, class Alloc>
+struct rb_serializer_imp;
+
+template<class T, class Alloc>
+struct rb_fd_io_imp;
+
+template
+    <
+        class T
+        , class Alloc
+        , bool trivial = std::is_trivially_copyable<T>::value
+    >
+    struct rb_help_bulk_imp;
 }
 
 template<class T, class Alloc>
@@ -49,8 +64,8 @@ class RingBuffer
 public:
     typedef Alloc allocator_type;
     typedef typename Alloc::value_type value_type;
-    typedef typename Alloc::reference reference;
-    typedef typename Alloc::const_reference const_reference;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
     typedef typename Alloc::difference_type difference_type;
     typedef typename Alloc::size_type size_type;
     
@@ -79,10 +94,30 @@ public:
     void emplace_back(Args&&...);
     void pop_front();
     
+    // pushes count values, the oldest elements are overwritten when they don't fit
+    void append(const T* values, size_type count);
+    // moves up to count oldest elements to out, returns how many were moved
+    size_type pop_front(T* out, size_type count);
+    
+    // non-temporal stores on push for trivially copyable T: data written once
+    // and read much later by another core doesn't evict the writer's caches
+    void set_streaming_stores(bool enable);
+    bool streaming_stores() const;
+    
     void swap(RingBuffer& other) noexcept;
     size_type size() const;
     size_type capacity() const;
     bool empty() const;
+    
+    // total number of elements ever pushed, including overwritten ones
+    size_type push_count() const;
+    
+    // contiguous parts of the content: array_one is the older one,
+    // array_two is empty unless the content wraps around the storage end
+    std::pair<T*, size_type> array_one();
+    std::pair<const T*, size_type> array_one() const;
+    std::pair<T*, size_type> array_two();
+    std::pair<const T*, size_type> array_two() const;
   
 private:
     template<class Pointer, class Reference>
@@ -155,6 +190,9 @@ public:
 private:
     friend struct Details::rb_help_push_back_copy_full_imp<T, Alloc>;
     friend struct Details::rb_help_push_back_move_full_imp<T, Alloc>;
+    friend struct Details::rb_serializer_imp<T, Alloc>;
+    friend struct Details::rb_fd_io_imp<T, Alloc>;
+    friend struct Details::rb_help_bulk_imp<T, Alloc>;
     
     // when buffer is non full imp
     template<class... Args>
@@ -178,11 +216,14 @@ private:
     size_type m_start;
     size_type m_capacity;
     size_type m_size;
+    size_type m_pushCount;
+    bool m_streamingStores;
     Alloc m_allocator;
     
 };
 
 #include "RingBuffer_PushBack.hpp"
+#include "RingBuffer_Bulk.hpp"
 #include "RingBuffer.hpp"
 #include "RingBufferIterator.hpp"
 
@@ -1,6 +1,7 @@
 #include "RingBuffer.h"
 #include <stdexcept>
 #include <cassert>
+#include <algorithm>
 
 #define RB_IMP RingBuffer<T, Alloc>
 #define RB_IMP_IT typename RingBuffer<T, Alloc>::iterator
@@ -12,6 +13,8 @@ RingBuffer<T, Alloc>::RingBuffer(size_type capacity, const Alloc &alloc)
     , m_allocator(alloc)
     , m_size(0)
     , m_start(0)
+    , m_pushCount(0)
+    , m_streamingStores(false)
 {
     m_data = std::allocator_traits<Alloc>::allocate
     (
@@ -26,6 +29,8 @@ RingBuffer<T, Alloc>::RingBuffer(const RingBuffer &other)
     , m_allocator(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.m_allocator))
     , m_size(0)
     , m_start(other.m_start)
+    , m_pushCount(0)
+    , m_streamingStores(false)
 {
     m_data = std::allocator_traits<Alloc>::allocate
     (
@@ -36,6 +41,8 @@ RingBuffer<T, Alloc>::RingBuffer(const RingBuffer &other)
     for (size_type pos = 0; pos < other.m_size; ++pos)
         push_back(other[pos]);
     
+    m_pushCount = other.m_pushCount;
+    m_streamingStores = other.m_streamingStores;
 }
 
 template<class T, class Alloc>
@@ -51,6 +58,8 @@ RingBuffer<T, Alloc>::RingBuffer(RingBuffer &&other)
     , m_allocator(std::move(other.m_allocator))
     , m_size(other.m_size)
     , m_start(other.m_start)
+    , m_pushCount(other.m_pushCount)
+    , m_streamingStores(other.m_streamingStores)
     , m_data(other.m_data)
 
 {
@@ -58,6 +67,7 @@ RingBuffer<T, Alloc>::RingBuffer(RingBuffer &&other)
     other.m_start = 0;
     other.m_capacity = 0;
     other.m_size = 0;
+    other.m_pushCount = 0;
 }
 
 template<class T, class Alloc>
@@ -136,6 +146,9 @@ template<class T, class Alloc>
 void RingBuffer<T, Alloc>::reallocate(size_type capacity)
 {
     RingBuffer temp(capacity);
+    // settings and the push history survive the resize
+    temp.m_pushCount = m_pushCount;
+    temp.m_streamingStores = m_streamingStores;
     swap(temp);
 }
 
@@ -158,7 +171,9 @@ void RingBuffer<T, Alloc>::clear()
 template<class T, class Alloc>
 void RingBuffer<T, Alloc>::push_back(const T& value)
 {
-    if (m_size < m_capacity)
+    if (m_streamingStores)
+        Details::rb_help_bulk_imp<T, Alloc>::push_back_streaming(*this, value);
+    else if (m_size < m_capacity)
         push_back_non_full_imp(value);
     else
         push_back_full_imp(value);
@@ -167,8 +182,10 @@ void RingBuffer<T, Alloc>::push_back(const T& value)
 template<class T, class Alloc>
 void RingBuffer<T, Alloc>::push_back(T&& value)
 {
-    if (m_size < m_capacity)
-        push_back_non_full_imp(value);
+    if (m_streamingStores)
+        Details::rb_help_bulk_imp<T, Alloc>::push_back_streaming(*this, value);
+    else if (m_size < m_capacity)
+        push_back_non_full_imp(std::move(value));
     else
         push_back_full_imp(std::move(value));
 }
@@ -198,6 +215,43 @@ void RingBuffer<T, Alloc>::pop_front()
     --m_size;
 }
 
+template<class T, class Alloc>
+void RingBuffer<T, Alloc>::append(const T* values, size_type count)
+{
+    Details::rb_help_bulk_imp<T, Alloc>::append(*this, values, count);
+}
+
+template<class T, class Alloc>
+typename RB_IMP::size_type RingBuffer<T, Alloc>::pop_front(T* out, size_type count)
+{
+    // prefetch about half a kilobyte, but at least one element, ahead
+    const size_type ahead = sizeof(T) < 512 ? 512 / sizeof(T) : 1;
+    
+    count = std::min(count, m_size);
+    for (size_type pos = 0; pos < count; ++pos)
+    {
+        if (pos + ahead < count)
+            Details::rb_prefetch(m_data + (m_start + ahead) % m_capacity, sizeof(T));
+        
+        out[pos] = std::move(m_data[m_start]);
+        pop_front();
+    }
+    
+    return count;
+}
+
+template<class T, class Alloc>
+void RingBuffer<T, Alloc>::set_streaming_stores(bool enable)
+{
+    m_streamingStores = enable && std::is_trivially_copyable<T>::value;
+}
+
+template<class T, class Alloc>
+bool RingBuffer<T, Alloc>::streaming_stores() const
+{
+    return m_streamingStores;
+}
+
 template<class T, class Alloc>
 void RingBuffer<T, Alloc>::swap(RingBuffer& other) noexcept
 {
@@ -205,6 +259,8 @@ void RingBuffer<T, Alloc>::swap(RingBuffer& other) noexcept
     std::swap(m_start, other.m_start);
     std::swap(m_capacity, other.m_capacity);
     std::swap(m_size, other.m_size);
+    std::swap(m_pushCount, other.m_pushCount);
+    std::swap(m_streamingStores, other.m_streamingStores);
 }
 
 template<class T, class Alloc>
@@ -225,6 +281,40 @@ bool RingBuffer<T, Alloc>::empty() const
     return m_size == 0;
 }
 
+template<class T, class Alloc>
+typename RB_IMP::size_type RingBuffer<T, Alloc>::push_count() const
+{
+    return m_pushCount;
+}
+
+template<class T, class Alloc>
+std::pair<T*, typename RB_IMP::size_type> RingBuffer<T, Alloc>::array_one()
+{
+    auto first_size = std::min(m_size, m_capacity - m_start);
+    return std::make_pair(m_data + m_start, first_size);
+}
+
+template<class T, class Alloc>
+std::pair<const T*, typename RB_IMP::size_type> RingBuffer<T, Alloc>::array_one() const
+{
+    auto first_size = std::min(m_size, m_capacity - m_start);
+    return std::pair<const T*, size_type>(m_data + m_start, first_size);
+}
+
+template<class T, class Alloc>
+std::pair<T*, typename RB_IMP::size_type> RingBuffer<T, Alloc>::array_two()
+{
+    auto first_size = std::min(m_size, m_capacity - m_start);
+    return std::make_pair(m_data, m_size - first_size);
+}
+
+template<class T, class Alloc>
+std::pair<const T*, typename RB_IMP::size_type> RingBuffer<T, Alloc>::array_two() const
+{
+    auto first_size = std::min(m_size, m_capacity - m_start);
+    return std::pair<const T*, size_type>(m_data, m_size - first_size);
+}
+
 template<class T, class Alloc>
 RB_IMP_IT RingBuffer<T, Alloc>::begin()
 {
@@ -273,6 +363,7 @@ void RingBuffer<T, Alloc>::push_back_non_full_imp(Args&&... args)
         , std::forward<Args>(args)...
     );
     ++m_size;
+    ++m_pushCount;
 }
 
 // dispatches
@@ -296,6 +387,7 @@ void RingBuffer<T, Alloc>::push_back_full_copy_imp(const T& value)
 {
     m_data[m_start] = value;
     m_start = (m_start + 1) % m_capacity;
+    ++m_pushCount;
 }
 
 template<class T, class Alloc>
@@ -303,6 +395,7 @@ void RingBuffer<T, Alloc>::push_back_full_move_imp(T&& value)
 {
     m_data[m_start] = std::move(value);
     m_start = (m_start + 1) % m_capacity;
+    ++m_pushCount;
 }
 
 template<class T, class Alloc>
@@ -326,6 +419,7 @@ void RingBuffer<T, Alloc>::push_back_destruct_construct_full_imp(Args&&... args)
     ++m_size;
     
     m_start = (m_start + 1) % m_capacity;
+    ++m_pushCount;
 }
 
 // swap
@@ -0,0 +1,64 @@
+//
+//  RingBufferIO.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef RingBufferIO_h
+#define RingBufferIO_h
+
+#include "RingBuffer.h"
+#include <sys/types.h>
+#include <sys/uio.h>
+
+// File descriptor I/O straight to and from the ring storage of byte rings.
+// One readv or writev covers both contiguous parts, so a wrapped ring costs
+// one syscall and no scratch copy. Both return what the syscall returned:
+// the number of bytes transferred, 0 at end of file, or -1 with errno set.
+// A read into a full ring fails with ENOBUFS, so it is never mistaken for
+// end of file; a write from an empty ring or a zero max returns 0. EINTR is
+// retried; EAGAIN on nonblocking descriptors is returned to the caller with
+// the ring untouched. Partial transfers advance the ring by exactly the
+// bytes that moved. Writing to a closed socket or pipe raises SIGPIPE
+// unless the caller ignores it.
+
+namespace Details {
+
+template<class T, class Alloc>
+struct rb_fd_io_imp
+{
+    typedef RingBuffer<T, Alloc> buffer_type;
+    typedef typename buffer_type::size_type size_type;
+
+    static ssize_t read(buffer_type &buffer, int fd, size_type max);
+    static ssize_t write(buffer_type &buffer, int fd, size_type max);
+
+private:
+    static int fill(iovec *segments, T *first, size_type firstSize, T *second, size_type secondSize, size_type max);
+};
+
+}
+
+// appends up to max bytes read from fd into the free space, never overwrites
+template<class T, class Alloc>
+ssize_t read_from_fd
+    (
+        RingBuffer<T, Alloc> &buffer
+        , int fd
+        , typename RingBuffer<T, Alloc>::size_type max = typename RingBuffer<T, Alloc>::size_type(-1)
+    );
+
+// writes up to max of the oldest bytes to fd and pops what was written
+template<class T, class Alloc>
+ssize_t write_to_fd
+    (
+        RingBuffer<T, Alloc> &buffer
+        , int fd
+        , typename RingBuffer<T, Alloc>::size_type max = typename RingBuffer<T, Alloc>::size_type(-1)
+    );
+
+#include "RingBufferIO.hpp"
+
+#endif /* RingBufferIO_h */
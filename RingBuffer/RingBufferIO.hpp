@@ -0,0 +1,102 @@
+#include "RingBufferIO.h"
+#include <algorithm>
+#include <cerrno>
+#include <unistd.h>
+
+#define RB_IO_IMP Details::rb_fd_io_imp<T, Alloc>
+
+template<class T, class Alloc>
+ssize_t RB_IO_IMP::read(buffer_type &buffer, int fd, size_type max)
+{
+    static_assert(std::is_trivially_copyable<T>::value && sizeof(T) == 1, "fd I/O needs a ring of trivially copyable bytes");
+
+    auto end = buffer.m_capacity ? (buffer.m_start + buffer.m_size) % buffer.m_capacity : 0;
+    auto free = buffer.m_capacity - buffer.m_size;
+    if (free == 0)
+    {
+        errno = ENOBUFS;
+        return -1;
+    }
+
+    auto first = std::min(free, buffer.m_capacity - end);
+
+    iovec segments[2];
+    int count = fill(segments, buffer.m_data + end, first, buffer.m_data, free - first, max);
+    if (count == 0)
+        return 0;
+
+    ssize_t result;
+    do
+        result = ::readv(fd, segments, count);
+    while (result < 0 && errno == EINTR);
+
+    if (result > 0)
+    {
+        buffer.m_size += size_type(result);
+        buffer.m_pushCount += size_type(result);
+    }
+    return result;
+}
+
+template<class T, class Alloc>
+ssize_t RB_IO_IMP::write(buffer_type &buffer, int fd, size_type max)
+{
+    static_assert(std::is_trivially_copyable<T>::value && sizeof(T) == 1, "fd I/O needs a ring of trivially copyable bytes");
+
+    auto one = buffer.array_one();
+    auto two = buffer.array_two();
+
+    iovec segments[2];
+    int count = fill(segments, one.first, one.second, two.first, two.second, max);
+    if (count == 0)
+        return 0;
+
+    ssize_t result;
+    do
+        result = ::writev(fd, segments, count);
+    while (result < 0 && errno == EINTR);
+
+    if (result > 0)
+    {
+        // trivially copyable elements need no destruction
+        buffer.m_start = (buffer.m_start + size_type(result)) % buffer.m_capacity;
+        buffer.m_size -= size_type(result);
+    }
+    return result;
+}
+
+template<class T, class Alloc>
+int RB_IO_IMP::fill(iovec *segments, T *first, size_type firstSize, T *second, size_type secondSize, size_type max)
+{
+    firstSize = std::min(firstSize, max);
+    secondSize = std::min(secondSize, max - firstSize);
+
+    int count = 0;
+    if (firstSize)
+    {
+        segments[count].iov_base = first;
+        segments[count].iov_len = firstSize;
+        ++count;
+    }
+    if (secondSize)
+    {
+        segments[count].iov_base = second;
+        segments[count].iov_len = secondSize;
+        ++count;
+    }
+    return count;
+}
+
+template<class T, class Alloc>
+ssize_t read_from_fd(RingBuffer<T, Alloc> &buffer, int fd, typename RingBuffer<T, Alloc>::size_type max)
+{
+    return RB_IO_IMP::read(buffer, fd, max);
+}
+
+template<class T, class Alloc>
+ssize_t write_to_fd(RingBuffer<T, Alloc> &buffer, int fd, typename RingBuffer<T, Alloc>::size_type max)
+{
+    return RB_IO_IMP::write(buffer, fd, max);
+}
+
+#undef RB_IO_IMP
@@ -0,0 +1,109 @@
+//
+//  RingBufferParallel.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef RingBufferParallel_h
+#define RingBufferParallel_h
+
+#include "RingBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Parallel algorithms over the content of a RingBuffer. The content is cut
+// into contiguous chunks that never cross the storage end, so every chunk
+// is a plain array scan, and the chunks are spread over a thread pool.
+// Each algorithm blocks until the whole ring is processed; the first
+// exception thrown by a callback is rethrown to the caller.
+
+// Fixed set of worker threads; the calling thread takes part in every run.
+class RingBufferThreadPool
+{
+public:
+    typedef std::size_t size_type;
+
+    // threads counts the caller, 0 means one per hardware thread
+    explicit RingBufferThreadPool(size_type threads = 0);
+    RingBufferThreadPool(const RingBufferThreadPool &) = delete;
+    RingBufferThreadPool &operator=(const RingBufferThreadPool &) = delete;
+    ~RingBufferThreadPool();
+
+    size_type size() const;
+
+    // calls task(index) for every index in [0, tasks) and waits for all of them
+    void run(size_type tasks, const std::function<void(size_type)> &task);
+
+    // one per hardware thread, used by the overloads without a pool
+    static RingBufferThreadPool &shared();
+
+private:
+    void work();
+    void drain();
+
+// data
+private:
+    std::vector<std::thread> m_threads;
+    std::mutex m_runMutex;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(size_type)> *m_task;
+    size_type m_tasks;
+    std::atomic<size_type> m_next;
+    size_type m_active;
+    size_type m_generation;
+    std::exception_ptr m_error;
+    bool m_stop;
+};
+
+namespace Details {
+
+template<class Pointer>
+struct rb_parallel_chunk
+{
+    Pointer m_data;
+    std::size_t m_count;
+    std::size_t m_offset;  // position of m_data[0] in the ring
+};
+
+}
+
+// f(element) on every element, in no particular order
+template<class T, class Alloc, class Function>
+void parallel_for_each(RingBufferThreadPool &pool, RingBuffer<T, Alloc> &buffer, Function f);
+template<class T, class Alloc, class Function>
+void parallel_for_each(RingBuffer<T, Alloc> &buffer, Function f);
+
+// Each chunk folds its elements, oldest first, into a copy of identity with
+// op(Result, const T &); the chunk results are then merged with
+// combine(Result, Result), starting from identity. combine has to be
+// associative with identity as its neutral element and, unless ordered,
+// commutative. ordered merges the chunk results oldest first, which gives
+// the same result on every run with the same pool size.
+template<class T, class Alloc, class Result, class BinaryOp, class Combine>
+Result parallel_reduce(RingBufferThreadPool &pool, const RingBuffer<T, Alloc> &buffer, Result identity, BinaryOp op, Combine combine, bool ordered = false);
+template<class T, class Alloc, class Result, class BinaryOp, class Combine>
+Result parallel_reduce(const RingBuffer<T, Alloc> &buffer, Result identity, BinaryOp op, Combine combine, bool ordered = false);
+
+// out[pos] = f(buffer[pos]) for every pos, out is a random access iterator
+template<class T, class Alloc, class OutputIt, class Function>
+void parallel_transform_into(RingBufferThreadPool &pool, const RingBuffer<T, Alloc> &buffer, OutputIt out, Function f);
+template<class T, class Alloc, class OutputIt, class Function>
+void parallel_transform_into(const RingBuffer<T, Alloc> &buffer, OutputIt out, Function f);
+
+template<class T, class Alloc, class Predicate>
+typename RingBuffer<T, Alloc>::size_type parallel_count_if(RingBufferThreadPool &pool, const RingBuffer<T, Alloc> &buffer, Predicate predicate);
+template<class T, class Alloc, class Predicate>
+typename RingBuffer<T, Alloc>::size_type parallel_count_if(const RingBuffer<T, Alloc> &buffer, Predicate predicate);
+
+#include "RingBufferParallel.hpp"
+
+#endif /* RingBufferParallel_h */
@@ -0,0 +1,248 @@
+#include "RingBufferParallel.h"
+#include <algorithm>
+
+// pool
+
+inline RingBufferThreadPool::RingBufferThreadPool(size_type threads)
+    : m_task(nullptr)
+    , m_tasks(0)
+    , m_next(0)
+    , m_active(0)
+    , m_generation(0)
+    , m_stop(false)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_type thread = 1; thread < threads; ++thread)
+        m_threads.emplace_back(&RingBufferThreadPool::work, this);
+}
+
+inline RingBufferThreadPool::~RingBufferThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (auto &thread : m_threads)
+        thread.join();
+}
+
+inline RingBufferThreadPool::size_type RingBufferThreadPool::size() const
+{
+    return m_threads.size() + 1;
+}
+
+inline void RingBufferThreadPool::run(size_type tasks, const std::function<void(size_type)> &task)
+{
+    std::lock_guard<std::mutex> running(m_runMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_tasks = tasks;
+        m_next.store(0, std::memory_order_relaxed);
+        m_active = m_threads.size();
+        m_error = nullptr;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_active == 0; });
+    m_task = nullptr;
+
+    if (m_error)
+    {
+        auto error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+inline RingBufferThreadPool &RingBufferThreadPool::shared()
+{
+    static RingBufferThreadPool pool;
+    return pool;
+}
+
+inline void RingBufferThreadPool::work()
+{
+    size_type seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop)
+                return;
+            seen = m_generation;
+        }
+
+        drain();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_active == 0)
+            m_done.notify_all();
+    }
+}
+
+inline void RingBufferThreadPool::drain()
+{
+    for (;;)
+    {
+        auto index = m_next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= m_tasks)
+            return;
+
+        try
+        {
+            (*m_task)(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_error)
+                m_error = std::current_exception();
+        }
+    }
+}
+
+namespace Details {
+
+// smaller chunks are not worth a task
+enum { rb_parallel_grain = 1 << 14 };
+
+// a few chunks per thread, so uneven callbacks still balance
+template<class Pointer>
+std::vector<rb_parallel_chunk<Pointer>> rb_parallel_split
+    (
+        std::pair<Pointer, std::size_t> one
+        , std::pair<Pointer, std::size_t> two
+        , std::size_t threads
+    )
+{
+    auto total = one.second + two.second;
+    auto pieces = threads * 4;
+    auto chunk = std::max<std::size_t>(rb_parallel_grain, (total + pieces - 1) / pieces);
+
+    std::vector<rb_parallel_chunk<Pointer>> chunks;
+    std::size_t offset = 0;
+    for (auto segment : { one, two })
+    {
+        for (std::size_t pos = 0; pos < segment.second; pos += chunk)
+        {
+            rb_parallel_chunk<Pointer> added;
+            added.m_data = segment.first + pos;
+            added.m_count = std::min(chunk, segment.second - pos);
+            added.m_offset = offset;
+            offset += added.m_count;
+            chunks.push_back(added);
+        }
+    }
+    return chunks;
+}
+
+}
+
+// algorithms
+
+template<class T, class Alloc, class Function>
+void parallel_for_each(RingBufferThreadPool &pool, RingBuffer<T, Alloc> &buffer, Function f)
+{
+    auto chunks = Details::rb_parallel_split(buffer.array_one(), buffer.array_two(), pool.size());
+    pool.run(chunks.size(), [&](std::size_t index) {
+        auto &chunk = chunks[index];
+        for (std::size_t pos = 0; pos < chunk.m_count; ++pos)
+            f(chunk.m_data[pos]);
+    });
+}
+
+template<class T, class Alloc, class Function>
+void parallel_for_each(RingBuffer<T, Alloc> &buffer, Function f)
+{
+    parallel_for_each(RingBufferThreadPool::shared(), buffer, f);
+}
+
+template<class T, class Alloc, class Result, class BinaryOp, class Combine>
+Result parallel_reduce(RingBufferThreadPool &pool, const RingBuffer<T, Alloc> &buffer, Result identity, BinaryOp op, Combine combine, bool ordered)
+{
+    auto chunks = Details::rb_parallel_split(buffer.array_one(), buffer.array_two(), pool.size());
+
+    std::vector<Result> partials;
+    if (ordered)
+        partials.resize(chunks.size(), identity);
+
+    Result result = identity;
+    std::mutex mutex;
+    pool.run(chunks.size(), [&](std::size_t index) {
+        auto &chunk = chunks[index];
+        Result partial = identity;
+        for (std::size_t pos = 0; pos < chunk.m_count; ++pos)
+            partial = op(std::move(partial), chunk.m_data[pos]);
+
+        if (ordered)
+        {
+            partials[index] = std::move(partial);
+            return;
+        }
+
+        // merged as soon as the chunk is done
+        std::lock_guard<std::mutex> lock(mutex);
+        result = combine(std::move(result), std::move(partial));
+    });
+
+    for (auto &partial : partials)
+        result = combine(std::move(result), std::move(partial));
+    return result;
+}
+
+template<class T, class Alloc, class Result, class BinaryOp, class Combine>
+Result parallel_reduce(const RingBuffer<T, Alloc> &buffer, Result identity, BinaryOp op, Combine combine, bool ordered)
+{
+    return parallel_reduce(RingBufferThreadPool::shared(), buffer, std::move(identity), op, combine, ordered);
+}
+
+template<class T, class Alloc, class OutputIt, class Function>
+void parallel_transform_into(RingBufferThreadPool &pool, const RingBuffer<T, Alloc> &buffer, OutputIt out, Function f)
+{
+    auto chunks = Details::rb_parallel_split(buffer.array_one(), buffer.array_two(), pool.size());
+    pool.run(chunks.size(), [&](std::size_t index) {
+        auto &chunk = chunks[index];
+        auto to = out + chunk.m_offset;
+        for (std::size_t pos = 0; pos < chunk.m_count; ++pos, ++to)
+            *to = f(chunk.m_data[pos]);
+    });
+}
+
+template<class T, class Alloc, class OutputIt, class Function>
+void parallel_transform_into(const RingBuffer<T, Alloc> &buffer, OutputIt out, Function f)
+{
+    parallel_transform_into(RingBufferThreadPool::shared(), buffer, out, f);
+}
+
+template<class T, class Alloc, class Predicate>
+typename RingBuffer<T, Alloc>::size_type parallel_count_if(RingBufferThreadPool &pool, const RingBuffer<T, Alloc> &buffer, Predicate predicate)
+{
+    typedef typename RingBuffer<T, Alloc>::size_type size_type;
+
+    auto chunks = Details::rb_parallel_split(buffer.array_one(), buffer.array_two(), pool.size());
+    std::atomic<size_type> count(0);
+    pool.run(chunks.size(), [&](std::size_t index) {
+        auto &chunk = chunks[index];
+        size_type matched = 0;
+        for (std::size_t pos = 0; pos < chunk.m_count; ++pos)
+            matched += predicate(chunk.m_data[pos]) ? 1 : 0;
+        count.fetch_add(matched, std::memory_order_relaxed);
+    });
+    return count.load(std::memory_order_relaxed);
+}
+
+template<class T, class Alloc, class Predicate>
+typename RingBuffer<T, Alloc>::size_type parallel_count_if(const RingBuffer<T, Alloc> &buffer, Predicate predicate)
+{
+    return parallel_count_if(RingBufferThreadPool::shared(), buffer, predicate);
+}
@@ -0,0 +1,104 @@
+//
+//  RingBufferSerialization.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef RingBufferSerialization_h
+#define RingBufferSerialization_h
+
+#include "RingBuffer.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+// Checkpoint layout: rb_serial_header followed by the elements, oldest first.
+// Trivially copyable elements are written raw, in host byte order, straight
+// from the ring storage. Other types need a codec providing
+//     void write(std::ostream &, const T &);
+//     T read(std::istream &);
+
+namespace Details {
+
+struct rb_serial_header
+{
+    std::uint32_t magic;
+    std::uint32_t flags;
+    std::uint64_t elementSize;  // 0 when written with a codec
+    std::uint64_t capacity;
+    std::uint64_t size;         // ring size at checkpoint
+    std::uint64_t pushCount;    // ring push_count at checkpoint
+    std::uint64_t base;         // push_count a delta was taken since, 0 for full ones
+    std::uint64_t count;        // elements following the header
+};
+
+// selects the raw memory path
+struct rb_raw_codec
+{
+};
+
+template<class T, class Alloc>
+struct rb_serializer_imp
+{
+    typedef RingBuffer<T, Alloc> buffer_type;
+    typedef typename buffer_type::size_type size_type;
+
+    template<class Codec>
+    static void write(std::ostream &os, const buffer_type &buffer, size_type count, bool delta, size_type since, Codec &codec);
+    template<class Codec>
+    static void read(std::istream &is, buffer_type &buffer, Codec &codec);
+
+private:
+    static void write_elements(std::ostream &os, const buffer_type &buffer, size_type count, rb_raw_codec &);
+    template<class Codec>
+    static void write_elements(std::ostream &os, const buffer_type &buffer, size_type count, Codec &codec);
+
+    static void read_full(std::istream &is, buffer_type &buffer, size_type size, rb_raw_codec &);
+    template<class Codec>
+    static void read_full(std::istream &is, buffer_type &buffer, size_type size, Codec &codec);
+
+    static T read_element(std::istream &is, rb_raw_codec &);
+    template<class Codec>
+    static T read_element(std::istream &is, Codec &codec);
+};
+
+}
+
+// full checkpoint of the content
+template<class T, class Alloc>
+void serialize(std::ostream &os, const RingBuffer<T, Alloc> &buffer);
+template<class T, class Alloc, class Codec>
+void serialize(std::ostream &os, const RingBuffer<T, Alloc> &buffer, Codec &codec);
+
+// only elements pushed after buffer.push_count() was equal to since,
+// pops done in the meantime are carried by the recorded size; it applies
+// to a replica whose push_count is between since and the checkpoint's
+// and which holds every element the checkpoint still has
+template<class T, class Alloc>
+void serialize_delta
+    (
+        std::ostream &os
+        , const RingBuffer<T, Alloc> &buffer
+        , typename RingBuffer<T, Alloc>::size_type since
+    );
+template<class T, class Alloc, class Codec>
+void serialize_delta
+    (
+        std::ostream &os
+        , const RingBuffer<T, Alloc> &buffer
+        , typename RingBuffer<T, Alloc>::size_type since
+        , Codec &codec
+    );
+
+// restores a full checkpoint into buffer, storing it from the first slot on,
+// or applies a delta checkpoint on top of the current content
+template<class T, class Alloc>
+void deserialize(std::istream &is, RingBuffer<T, Alloc> &buffer);
+template<class T, class Alloc, class Codec>
+void deserialize(std::istream &is, RingBuffer<T, Alloc> &buffer, Codec &codec);
+
+#include "RingBufferSerialization.hpp"
+
+#endif /* RingBufferSerialization_h */
@@ -0,0 +1,240 @@
+#include "RingBufferSerialization.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#define RB_SER_IMP Details::rb_serializer_imp<T, Alloc>
+
+namespace Details {
+
+enum
+{
+    rb_serial_magic = 0x52425546 // "RBUF"
+    , rb_serial_delta = 1
+    , rb_serial_raw = 2
+};
+
+inline void rb_serial_check(std::ios &stream)
+{
+    if (!stream)
+        throw std::runtime_error("ring buffer checkpoint stream failed");
+}
+
+inline void rb_serial_write_raw(std::ostream &os, const void *data, std::size_t bytes)
+{
+    if (bytes)
+        os.write(static_cast<const char *>(data), bytes);
+}
+
+inline void rb_serial_read_raw(std::istream &is, void *data, std::size_t bytes)
+{
+    if (bytes)
+        is.read(static_cast<char *>(data), bytes);
+    rb_serial_check(is);
+}
+
+}
+
+template<class T, class Alloc>
+template<class Codec>
+void RB_SER_IMP::write(std::ostream &os, const buffer_type &buffer, size_type count, bool delta, size_type since, Codec &codec)
+{
+    bool raw = std::is_same<Codec, rb_raw_codec>::value;
+
+    rb_serial_header header;
+    header.magic = rb_serial_magic;
+    header.flags = (delta ? rb_serial_delta : 0) | (raw ? rb_serial_raw : 0);
+    header.elementSize = raw ? sizeof(T) : 0;
+    header.capacity = buffer.m_capacity;
+    header.size = buffer.m_size;
+    header.pushCount = buffer.m_pushCount;
+    header.count = count;
+    header.base = delta ? since : 0;
+
+    rb_serial_write_raw(os, &header, sizeof(header));
+    write_elements(os, buffer, count, codec);
+    rb_serial_check(os);
+}
+
+template<class T, class Alloc>
+template<class Codec>
+void RB_SER_IMP::read(std::istream &is, buffer_type &buffer, Codec &codec)
+{
+    rb_serial_header header;
+    rb_serial_read_raw(is, &header, sizeof(header));
+
+    bool raw = std::is_same<Codec, rb_raw_codec>::value;
+    if (header.magic != rb_serial_magic
+        || ((header.flags & rb_serial_raw) != 0) != raw
+        || header.elementSize != (raw ? sizeof(T) : 0)
+        || header.count > header.size)
+        throw std::runtime_error("ring buffer checkpoint has incompatible format");
+
+    if (header.size > buffer.m_capacity)
+        throw std::length_error("ring buffer checkpoint exceeds capacity");
+
+    if (!(header.flags & rb_serial_delta))
+    {
+        read_full(is, buffer, header.size, codec);
+        buffer.m_pushCount = header.pushCount;
+        return;
+    }
+
+    // a replica ahead of the checkpoint has elements the source never had
+    if (buffer.m_pushCount > header.pushCount)
+        throw std::runtime_error("ring buffer delta checkpoint is behind the content");
+
+    // unless the delta carries the whole content, the replica has to have
+    // seen everything pushed up to its base
+    bool complete = header.count == header.size;
+    if (buffer.m_pushCount < header.base && !complete)
+        throw std::runtime_error("ring buffer delta checkpoint does not follow the content");
+
+    // push_count of the first element in the delta
+    auto first = header.pushCount - header.count;
+    bool restart = first > buffer.m_pushCount;
+
+    // a replica which dropped elements the source still holds has diverged
+    auto present = restart ? 0 : buffer.m_pushCount - first;
+    auto kept = restart ? 0 : buffer.m_size;
+    if (kept + (header.count - present) < header.size)
+        throw std::runtime_error("ring buffer delta checkpoint does not match the content");
+
+    if (restart)
+        buffer.clear();
+
+    for (std::uint64_t pos = 0; pos < header.count; ++pos)
+    {
+        T value = read_element(is, codec);
+        if (pos >= present)
+            buffer.push_back(std::move(value));
+    }
+
+    while (buffer.m_size > header.size)
+        buffer.pop_front();
+    buffer.m_pushCount = header.pushCount;
+}
+
+template<class T, class Alloc>
+void RB_SER_IMP::write_elements(std::ostream &os, const buffer_type &buffer, size_type count, rb_raw_codec &)
+{
+    // the newest count elements, at most two contiguous writes
+    auto one = buffer.array_one();
+    auto two = buffer.array_two();
+    auto skip = buffer.m_size - count;
+
+    if (skip < one.second)
+        rb_serial_write_raw(os, one.first + skip, (one.second - skip) * sizeof(T));
+    else
+        two = std::make_pair(two.first + (skip - one.second), two.second - (skip - one.second));
+
+    rb_serial_write_raw(os, two.first, two.second * sizeof(T));
+}
+
+template<class T, class Alloc>
+template<class Codec>
+void RB_SER_IMP::write_elements(std::ostream &os, const buffer_type &buffer, size_type count, Codec &codec)
+{
+    for (size_type pos = buffer.m_size - count; pos < buffer.m_size; ++pos)
+        codec.write(os, buffer[pos]);
+}
+
+template<class T, class Alloc>
+void RB_SER_IMP::read_full(std::istream &is, buffer_type &buffer, size_type size, rb_raw_codec &)
+{
+    buffer.clear();
+    buffer.m_start = 0;
+
+    rb_serial_read_raw(is, buffer.m_data, size * sizeof(T));
+    buffer.m_size = size;
+}
+
+template<class T, class Alloc>
+template<class Codec>
+void RB_SER_IMP::read_full(std::istream &is, buffer_type &buffer, size_type size, Codec &codec)
+{
+    buffer.clear();
+    buffer.m_start = 0;
+
+    for (size_type pos = 0; pos < size; ++pos)
+        buffer.push_back(read_element(is, codec));
+}
+
+template<class T, class Alloc>
+T RB_SER_IMP::read_element(std::istream &is, rb_raw_codec &)
+{
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    rb_serial_read_raw(is, &storage, sizeof(T));
+
+    T value;
+    std::memcpy(&value, &storage, sizeof(T));
+    return value;
+}
+
+template<class T, class Alloc>
+template<class Codec>
+T RB_SER_IMP::read_element(std::istream &is, Codec &codec)
+{
+    T value = codec.read(is);
+    Details::rb_serial_check(is);
+    return value;
+}
+
+// public interface
+
+template<class T, class Alloc>
+void serialize(std::ostream &os, const RingBuffer<T, Alloc> &buffer)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "raw serialization needs trivially copyable type, use a codec");
+    Details::rb_raw_codec codec;
+    RB_SER_IMP::write(os, buffer, buffer.size(), false, 0, codec);
+}
+
+template<class T, class Alloc, class Codec>
+void serialize(std::ostream &os, const RingBuffer<T, Alloc> &buffer, Codec &codec)
+{
+    RB_SER_IMP::write(os, buffer, buffer.size(), false, 0, codec);
+}
+
+template<class T, class Alloc>
+void serialize_delta
+    (
+        std::ostream &os
+        , const RingBuffer<T, Alloc> &buffer
+        , typename RingBuffer<T, Alloc>::size_type since
+    )
+{
+    static_assert(std::is_trivially_copyable<T>::value, "raw serialization needs trivially copyable type, use a codec");
+    assert(since <= buffer.push_count());
+    Details::rb_raw_codec codec;
+    RB_SER_IMP::write(os, buffer, std::min(buffer.push_count() - since, buffer.size()), true, since, codec);
+}
+
+template<class T, class Alloc, class Codec>
+void serialize_delta
+    (
+        std::ostream &os
+        , const RingBuffer<T, Alloc> &buffer
+        , typename RingBuffer<T, Alloc>::size_type since
+        , Codec &codec
+    )
+{
+    assert(since <= buffer.push_count());
+    RB_SER_IMP::write(os, buffer, std::min(buffer.push_count() - since, buffer.size()), true, since, codec);
+}
+
+template<class T, class Alloc>
+void deserialize(std::istream &is, RingBuffer<T, Alloc> &buffer)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "raw serialization needs trivially copyable type, use a codec");
+    Details::rb_raw_codec codec;
+    RB_SER_IMP::read(is, buffer, codec);
+}
+
+template<class T, class Alloc, class Codec>
+void deserialize(std::istream &is, RingBuffer<T, Alloc> &buffer, Codec &codec)
+{
+    RB_SER_IMP::read(is, buffer, codec);
+}
+
+#undef RB_SER_IMP
@@ -0,0 +1,139 @@
+#include "RingBuffer.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define RB_HAS_STREAMING_STORES 1
+#endif
+
+namespace Details {
+
+    enum { rb_cache_line = 64 };
+
+    // copies bytes with non-temporal stores where the target allows it,
+    // caller has to issue rb_stream_fence before publishing the data
+    inline void rb_stream_copy(void *dst, const void *src, std::size_t bytes)
+    {
+#ifdef RB_HAS_STREAMING_STORES
+        auto to = static_cast<char *>(dst);
+        auto from = static_cast<const char *>(src);
+
+        std::size_t head = (16 - (reinterpret_cast<std::uintptr_t>(to) & 15)) & 15;
+        head = std::min(head, bytes);
+        std::memcpy(to, from, head);
+        to += head;
+        from += head;
+        bytes -= head;
+
+#ifdef __AVX__
+        if ((reinterpret_cast<std::uintptr_t>(to) & 31) == 0)
+        {
+            for (; bytes >= 32; to += 32, from += 32, bytes -= 32)
+                _mm256_stream_si256(reinterpret_cast<__m256i *>(to), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from)));
+        }
+#endif
+        for (; bytes >= 16; to += 16, from += 16, bytes -= 16)
+            _mm_stream_si128(reinterpret_cast<__m128i *>(to), _mm_loadu_si128(reinterpret_cast<const __m128i *>(from)));
+
+        std::memcpy(to, from, bytes);
+#else
+        std::memcpy(dst, src, bytes);
+#endif
+    }
+
+    inline void rb_stream_fence()
+    {
+#ifdef RB_HAS_STREAMING_STORES
+        _mm_sfence();
+#endif
+    }
+
+    inline void rb_prefetch(const void *address, std::size_t bytes)
+    {
+#if defined(__GNUC__)
+        auto from = static_cast<const char *>(address);
+        for (std::size_t offset = 0; offset < bytes; offset += rb_cache_line)
+            __builtin_prefetch(from + offset);
+#elif defined(RB_HAS_STREAMING_STORES)
+        auto from = static_cast<const char *>(address);
+        for (std::size_t offset = 0; offset < bytes; offset += rb_cache_line)
+            _mm_prefetch(from + offset, _MM_HINT_T0);
+#else
+        (void)address;
+        (void)bytes;
+#endif
+    }
+
+    // bulk
+
+    template<class T, class Alloc, bool trivial>
+    struct rb_help_bulk_imp
+    {
+        typedef typename RingBuffer<T, Alloc>::size_type size_type;
+
+        static void append(RingBuffer<T, Alloc> &buffer, const T *values, size_type count)
+        {
+            buffer.m_pushCount += count;
+            if (buffer.m_capacity == 0)
+                return;
+
+            // only the last capacity values survive
+            if (count > buffer.m_capacity)
+            {
+                values += count - buffer.m_capacity;
+                count = buffer.m_capacity;
+            }
+
+            auto free = buffer.m_capacity - buffer.m_size;
+            if (count > free)
+            {
+                buffer.m_start = (buffer.m_start + count - free) % buffer.m_capacity;
+                buffer.m_size -= count - free;
+            }
+
+            auto tail = (buffer.m_start + buffer.m_size) % buffer.m_capacity;
+            auto first = std::min(count, buffer.m_capacity - tail);
+            copy(buffer, buffer.m_data + tail, values, first);
+            copy(buffer, buffer.m_data, values + first, count - first);
+            if (buffer.m_streamingStores)
+                rb_stream_fence();
+
+            buffer.m_size += count;
+        }
+
+        static void push_back_streaming(RingBuffer<T, Alloc> &buffer, const T &value)
+        {
+            append(buffer, &value, 1);
+        }
+
+    private:
+        static void copy(RingBuffer<T, Alloc> &buffer, T *dst, const T *src, size_type count)
+        {
+            if (buffer.m_streamingStores)
+                rb_stream_copy(dst, src, count * sizeof(T));
+            else if (count)
+                std::memcpy(dst, src, count * sizeof(T));
+        }
+    };
+
+    template<class T, class Alloc>
+    struct rb_help_bulk_imp<T, Alloc, false>
+    {
+        typedef typename RingBuffer<T, Alloc>::size_type size_type;
+
+        static void append(RingBuffer<T, Alloc> &buffer, const T *values, size_type count)
+        {
+            for (size_type pos = 0; pos < count; ++pos)
+                buffer.push_back(values[pos]);
+        }
+
+        static void push_back_streaming(RingBuffer<T, Alloc> &, const T &)
+        {
+            assert(!"streaming stores are never enabled for this type");
+        }
+    };
+
+}
@@ -0,0 +1,70 @@
+//
+//  SeqlockRingBuffer.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef SeqlockRingBuffer_h
+#define SeqlockRingBuffer_h
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+// Overwriting ring with one writer and any number of concurrent readers.
+// Every slot carries a sequence number telling which push it holds and
+// whether it is being written. The writer never locks nor waits, readers
+// copy slots out and retry only when the writer has lapped them.
+template<class T, class Alloc = std::allocator<T>>
+class SeqlockRingBuffer
+{
+    static_assert(std::is_trivially_copyable<T>::value, "seqlock readers copy raw slots, T must be trivially copyable");
+
+public:
+    typedef Alloc allocator_type;
+    typedef T value_type;
+    typedef typename std::allocator_traits<Alloc>::size_type size_type;
+
+    explicit SeqlockRingBuffer(size_type capacity, const Alloc &alloc = Alloc());
+    SeqlockRingBuffer(const SeqlockRingBuffer &) = delete;
+    SeqlockRingBuffer &operator=(const SeqlockRingBuffer &) = delete;
+    ~SeqlockRingBuffer();
+
+    // writer thread only, overwrites the oldest element when full
+    void push_back(const T &value);
+
+    // any thread; copies the newest min(count, size) elements, oldest first,
+    // all of them as they were at one moment, and returns how many were copied
+    size_type read_latest(T *out, size_type count) const;
+    // any thread; false when nothing was pushed yet
+    bool read_back(T &value) const;
+
+    size_type push_count() const;
+    size_type size() const;
+    size_type capacity() const;
+
+private:
+    struct slot
+    {
+        // 2 * n + 1 while push n is written, 2 * n + 2 once it is complete
+        std::atomic<size_type> m_sequence;
+        T m_value;
+    };
+
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<slot> slot_allocator;
+
+    bool read_imp(size_type head, T *out, size_type count) const;
+
+// data
+private:
+    slot *m_slots;
+    size_type m_capacity;
+    slot_allocator m_allocator;
+    std::atomic<size_type> m_pushCount;
+};
+
+#include "SeqlockRingBuffer.hpp"
+
+#endif /* SeqlockRingBuffer_h */
@@ -0,0 +1,112 @@
+#include "SeqlockRingBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#define SRB_IMP SeqlockRingBuffer<T, Alloc>
+
+template<class T, class Alloc>
+SRB_IMP::SeqlockRingBuffer(size_type capacity, const Alloc &alloc)
+    : m_capacity(capacity)
+    , m_allocator(alloc)
+    , m_pushCount(0)
+{
+    m_slots = std::allocator_traits<slot_allocator>::allocate
+    (
+        m_allocator
+        , m_capacity
+    );
+
+    for (size_type pos = 0; pos < m_capacity; ++pos)
+        new (&m_slots[pos].m_sequence) std::atomic<size_type>(0);
+}
+
+template<class T, class Alloc>
+SRB_IMP::~SeqlockRingBuffer()
+{
+    std::allocator_traits<slot_allocator>::deallocate
+    (
+        m_allocator
+        , m_slots
+        , m_capacity
+    );
+}
+
+template<class T, class Alloc>
+void SRB_IMP::push_back(const T &value)
+{
+    if (m_capacity == 0)
+        return;
+
+    auto push = m_pushCount.load(std::memory_order_relaxed);
+    slot &target = m_slots[push % m_capacity];
+
+    target.m_sequence.store(2 * push + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // readers may copy the slot meanwhile, the sequence check discards such copies
+    std::memcpy(&target.m_value, &value, sizeof(T));
+
+    target.m_sequence.store(2 * push + 2, std::memory_order_release);
+    m_pushCount.store(push + 1, std::memory_order_release);
+}
+
+template<class T, class Alloc>
+typename SRB_IMP::size_type SRB_IMP::read_latest(T *out, size_type count) const
+{
+    for (;;)
+    {
+        auto head = m_pushCount.load(std::memory_order_acquire);
+        auto available = std::min(count, std::min(head, m_capacity));
+        if (read_imp(head, out, available))
+            return available;
+    }
+}
+
+template<class T, class Alloc>
+bool SRB_IMP::read_back(T &value) const
+{
+    return read_latest(&value, 1) == 1;
+}
+
+template<class T, class Alloc>
+bool SRB_IMP::read_imp(size_type head, T *out, size_type count) const
+{
+    for (size_type pos = 0; pos < count; ++pos)
+    {
+        auto push = head - count + pos;
+        const slot &source = m_slots[push % m_capacity];
+
+        auto before = source.m_sequence.load(std::memory_order_acquire);
+        if (before != 2 * push + 2)
+            return false;
+
+        std::memcpy(out + pos, &source.m_value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (source.m_sequence.load(std::memory_order_relaxed) != before)
+            return false;
+    }
+
+    return true;
+}
+
+template<class T, class Alloc>
+typename SRB_IMP::size_type SRB_IMP::push_count() const
+{
+    return m_pushCount.load(std::memory_order_acquire);
+}
+
+template<class T, class Alloc>
+typename SRB_IMP::size_type SRB_IMP::size() const
+{
+    return std::min(push_count(), m_capacity);
+}
+
+template<class T, class Alloc>
+typename SRB_IMP::size_type SRB_IMP::capacity() const
+{
+    return m_capacity;
+}
+
+#undef SRB_IMP
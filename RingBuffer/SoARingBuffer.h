@@ -0,0 +1,187 @@
+//
+//  SoARingBuffer.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef SoARingBuffer_h
+#define SoARingBuffer_h
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+namespace Details {
+
+template<std::size_t... I>
+struct rb_index_sequence
+{
+};
+
+template<std::size_t N, std::size_t... I>
+struct rb_make_index_sequence : rb_make_index_sequence<N - 1, N - 1, I...>
+{
+};
+
+template<std::size_t... I>
+struct rb_make_index_sequence<0, I...>
+{
+    typedef rb_index_sequence<I...> type;
+};
+
+}
+
+// Ring of records stored as structure of arrays: one cache line aligned
+// column per field, sharing start and size. Rows are pushed as tuples and
+// seen through tuples of references, columns are scanned via column_one/two.
+// Like RingBuffer, pushing into a full ring overwrites the oldest row.
+template<class... Fields>
+class SoARingBuffer
+{
+    static_assert(sizeof...(Fields) > 0, "SoARingBuffer needs at least one field");
+
+public:
+    typedef std::tuple<Fields...> value_type;
+    typedef std::tuple<Fields&...> reference;
+    typedef std::tuple<const Fields&...> const_reference;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::size_t size_type;
+
+    template<std::size_t I>
+    using field_type = typename std::tuple_element<I, value_type>::type;
+
+    static const size_type column_alignment = 64;
+
+    explicit SoARingBuffer(size_type capacity);
+    SoARingBuffer(const SoARingBuffer &other);
+    SoARingBuffer &operator=(const SoARingBuffer &other);
+    SoARingBuffer(SoARingBuffer &&other);
+    SoARingBuffer &operator=(SoARingBuffer &&other);
+    ~SoARingBuffer();
+
+    reference front();
+    const_reference front() const;
+    reference back();
+    const_reference back() const;
+    reference operator[](size_type);
+    const_reference operator[](size_type) const;
+
+    // single field of a row
+    template<std::size_t I>
+    field_type<I> &get(size_type);
+    template<std::size_t I>
+    const field_type<I> &get(size_type) const;
+
+    void clear();
+    void push_back(const value_type &);
+    void push_back(value_type &&);
+    void pop_front();
+
+    void swap(SoARingBuffer &other) noexcept;
+    size_type size() const;
+    size_type capacity() const;
+    bool empty() const;
+
+    // contiguous parts of a column, same split as RingBuffer::array_one/two
+    template<std::size_t I>
+    std::pair<field_type<I> *, size_type> column_one();
+    template<std::size_t I>
+    std::pair<const field_type<I> *, size_type> column_one() const;
+    template<std::size_t I>
+    std::pair<field_type<I> *, size_type> column_two();
+    template<std::size_t I>
+    std::pair<const field_type<I> *, size_type> column_two() const;
+
+private:
+    template<class Owner, class Reference>
+    class iteratorImp {
+    public:
+        typedef SoARingBuffer::difference_type difference_type;
+        typedef SoARingBuffer::value_type value_type;
+        typedef Reference reference;
+        typedef void pointer;
+        typedef std::random_access_iterator_tag iterator_category;
+        friend class SoARingBuffer;
+
+        iteratorImp();
+    private:
+        iteratorImp(Owner *owner, size_type current);
+    public:
+
+        bool operator==(const iteratorImp&) const;
+        bool operator!=(const iteratorImp&) const;
+        bool operator<(const iteratorImp&) const;
+        bool operator>(const iteratorImp&) const;
+        bool operator<=(const iteratorImp&) const;
+        bool operator>=(const iteratorImp&) const;
+
+        iteratorImp& operator++();
+        iteratorImp operator++(int);
+        iteratorImp& operator--();
+        iteratorImp operator--(int);
+        iteratorImp& operator+=(size_type);
+        iteratorImp operator+(size_type) const;
+
+        friend iteratorImp operator+(size_type pos, const iteratorImp &it)
+        {
+            return it + pos;
+        }
+
+        iteratorImp& operator-=(size_type);
+        iteratorImp operator-(size_type) const;
+        difference_type operator-(const iteratorImp &) const;
+
+        Reference operator*() const;
+        Reference operator[](size_type) const;
+
+    private:
+        Owner *m_owner;
+        size_type m_current;
+    };
+public:
+
+    using iterator = iteratorImp<SoARingBuffer, reference>;
+    using const_iterator = iteratorImp<const SoARingBuffer, const_reference>;
+
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const;
+
+private:
+    typedef typename Details::rb_make_index_sequence<sizeof...(Fields)>::type indices;
+
+    size_type physical(size_type pos) const;
+
+    template<std::size_t... I>
+    void allocate_imp(Details::rb_index_sequence<I...>);
+    template<class Row, std::size_t... I>
+    void construct_row_imp(size_type pos, Row &&row, Details::rb_index_sequence<I...>);
+    template<std::size_t... I>
+    void destroy_row_imp(size_type pos, Details::rb_index_sequence<I...>);
+    template<std::size_t... I>
+    reference row_imp(size_type pos, Details::rb_index_sequence<I...>);
+    template<std::size_t... I>
+    const_reference row_imp(size_type pos, Details::rb_index_sequence<I...>) const;
+
+    template<class Row>
+    void push_back_imp(Row &&row);
+
+// data
+private:
+    void *m_storage;
+    std::tuple<Fields*...> m_columns;
+
+    size_type m_start;
+    size_type m_capacity;
+    size_type m_size;
+};
+
+#include "SoARingBuffer.hpp"
+
+#endif /* SoARingBuffer_h */
@@ -0,0 +1,491 @@
+#include "SoARingBuffer.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+#define SOA_IMP SoARingBuffer<Fields...>
+#define SOA_IT_IMP SoARingBuffer<Fields...>::iteratorImp<Owner, Reference>
+#define SOA_IT_RET typename SoARingBuffer<Fields...>::template iteratorImp<Owner, Reference>
+
+template<class... Fields>
+const typename SOA_IMP::size_type SOA_IMP::column_alignment;
+
+template<class... Fields>
+SOA_IMP::SoARingBuffer(size_type capacity)
+    : m_storage(nullptr)
+    , m_start(0)
+    , m_capacity(capacity)
+    , m_size(0)
+{
+    allocate_imp(indices());
+}
+
+template<class... Fields>
+SOA_IMP::SoARingBuffer(const SoARingBuffer &other)
+    : m_storage(nullptr)
+    , m_start(0)
+    , m_capacity(other.m_capacity)
+    , m_size(0)
+{
+    allocate_imp(indices());
+
+    for (size_type pos = 0; pos < other.m_size; ++pos)
+        push_back_imp(other[pos]);
+}
+
+template<class... Fields>
+SOA_IMP &SoARingBuffer<Fields...>::operator=(const SoARingBuffer &other)
+{
+    auto temp = other;
+    swap(temp);
+    return *this;
+}
+
+template<class... Fields>
+SOA_IMP::SoARingBuffer(SoARingBuffer &&other)
+    : m_storage(other.m_storage)
+    , m_columns(other.m_columns)
+    , m_start(other.m_start)
+    , m_capacity(other.m_capacity)
+    , m_size(other.m_size)
+{
+    other.m_storage = nullptr;
+    other.m_columns = std::tuple<Fields*...>();
+    other.m_start = 0;
+    other.m_capacity = 0;
+    other.m_size = 0;
+}
+
+template<class... Fields>
+SOA_IMP &SoARingBuffer<Fields...>::operator=(SoARingBuffer &&other)
+{
+    auto temp = std::move(other);
+    swap(temp);
+    return *this;
+}
+
+template<class... Fields>
+SOA_IMP::~SoARingBuffer()
+{
+    clear();
+    ::operator delete(m_storage);
+}
+
+template<class... Fields>
+typename SOA_IMP::reference SoARingBuffer<Fields...>::front()
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    return row_imp(m_start, indices());
+}
+
+template<class... Fields>
+typename SOA_IMP::const_reference SoARingBuffer<Fields...>::front() const
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    return row_imp(m_start, indices());
+}
+
+template<class... Fields>
+typename SOA_IMP::reference SoARingBuffer<Fields...>::back()
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    return row_imp(physical(m_size - 1), indices());
+}
+
+template<class... Fields>
+typename SOA_IMP::const_reference SoARingBuffer<Fields...>::back() const
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    return row_imp(physical(m_size - 1), indices());
+}
+
+template<class... Fields>
+typename SOA_IMP::reference SoARingBuffer<Fields...>::operator[](size_type pos)
+{
+    return row_imp(physical(pos), indices());
+}
+
+template<class... Fields>
+typename SOA_IMP::const_reference SoARingBuffer<Fields...>::operator[](size_type pos) const
+{
+    return row_imp(physical(pos), indices());
+}
+
+template<class... Fields>
+template<std::size_t I>
+typename SOA_IMP::template field_type<I> &SoARingBuffer<Fields...>::get(size_type pos)
+{
+    return std::get<I>(m_columns)[physical(pos)];
+}
+
+template<class... Fields>
+template<std::size_t I>
+const typename SOA_IMP::template field_type<I> &SoARingBuffer<Fields...>::get(size_type pos) const
+{
+    return std::get<I>(m_columns)[physical(pos)];
+}
+
+template<class... Fields>
+void SOA_IMP::clear()
+{
+    for (size_type pos = 0; pos < m_size; ++pos)
+        destroy_row_imp(physical(pos), indices());
+
+    m_size = 0;
+}
+
+template<class... Fields>
+void SOA_IMP::push_back(const value_type &row)
+{
+    push_back_imp(row);
+}
+
+template<class... Fields>
+void SOA_IMP::push_back(value_type &&row)
+{
+    push_back_imp(std::move(row));
+}
+
+template<class... Fields>
+void SOA_IMP::pop_front()
+{
+    if (empty())
+        throw std::range_error("ring buffer is empty");
+
+    destroy_row_imp(m_start, indices());
+    m_start = (m_start + 1) % m_capacity;
+    --m_size;
+}
+
+template<class... Fields>
+void SOA_IMP::swap(SoARingBuffer &other) noexcept
+{
+    std::swap(m_storage, other.m_storage);
+    std::swap(m_columns, other.m_columns);
+    std::swap(m_start, other.m_start);
+    std::swap(m_capacity, other.m_capacity);
+    std::swap(m_size, other.m_size);
+}
+
+template<class... Fields>
+typename SOA_IMP::size_type SoARingBuffer<Fields...>::size() const
+{
+    return m_size;
+}
+
+template<class... Fields>
+typename SOA_IMP::size_type SoARingBuffer<Fields...>::capacity() const
+{
+    return m_capacity;
+}
+
+template<class... Fields>
+bool SOA_IMP::empty() const
+{
+    return m_size == 0;
+}
+
+// columns
+
+template<class... Fields>
+template<std::size_t I>
+std::pair<typename SOA_IMP::template field_type<I> *, typename SOA_IMP::size_type> SoARingBuffer<Fields...>::column_one()
+{
+    auto first_size = std::min(m_size, m_capacity - m_start);
+    return std::pair<field_type<I> *, size_type>(std::get<I>(m_columns) + m_start, first_size);
+}
+
+template<class... Fields>
+template<std::size_t I>
+std::pair<const typename SOA_IMP::template field_type<I> *, typename SOA_IMP::size_type> SoARingBuffer<Fields...>::column_one() const
+{
+    auto first_size = std::min(m_size, m_capacity - m_start);
+    return std::pair<const field_type<I> *, size_type>(std::get<I>(m_columns) + m_start, first_size);
+}
+
+template<class... Fields>
+template<std::size_t I>
+std::pair<typename SOA_IMP::template field_type<I> *, typename SOA_IMP::size_type> SoARingBuffer<Fields...>::column_two()
+{
+    auto first_size = std::min(m_size, m_capacity - m_start);
+    return std::pair<field_type<I> *, size_type>(std::get<I>(m_columns), m_size - first_size);
+}
+
+template<class... Fields>
+template<std::size_t I>
+std::pair<const typename SOA_IMP::template field_type<I> *, typename SOA_IMP::size_type> SoARingBuffer<Fields...>::column_two() const
+{
+    auto first_size = std::min(m_size, m_capacity - m_start);
+    return std::pair<const field_type<I> *, size_type>(std::get<I>(m_columns), m_size - first_size);
+}
+
+// iterators
+
+template<class... Fields>
+typename SOA_IMP::iterator SoARingBuffer<Fields...>::begin()
+{
+    return iterator(this, 0);
+}
+
+template<class... Fields>
+typename SOA_IMP::const_iterator SoARingBuffer<Fields...>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+template<class... Fields>
+typename SOA_IMP::const_iterator SoARingBuffer<Fields...>::cbegin() const
+{
+    return begin();
+}
+
+template<class... Fields>
+typename SOA_IMP::iterator SoARingBuffer<Fields...>::end()
+{
+    return iterator(this, m_size);
+}
+
+template<class... Fields>
+typename SOA_IMP::const_iterator SoARingBuffer<Fields...>::end() const
+{
+    return const_iterator(this, m_size);
+}
+
+template<class... Fields>
+typename SOA_IMP::const_iterator SoARingBuffer<Fields...>::cend() const
+{
+    return end();
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+SOA_IT_IMP::iteratorImp()
+    : m_owner(nullptr)
+    , m_current(0)
+{
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+SOA_IT_IMP::iteratorImp(Owner *owner, size_type current)
+    : m_owner(owner)
+    , m_current(current)
+{
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+bool SOA_IT_IMP::operator==(const iteratorImp &other) const
+{
+    return m_owner == other.m_owner && m_current == other.m_current;
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+bool SOA_IT_IMP::operator!=(const iteratorImp &other) const
+{
+    return !(operator==(other));
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+bool SOA_IT_IMP::operator<(const iteratorImp &other) const
+{
+    assert(m_owner == other.m_owner);
+    return m_current < other.m_current;
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+bool SOA_IT_IMP::operator>(const iteratorImp &other) const
+{
+    return other < *this;
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+bool SOA_IT_IMP::operator<=(const iteratorImp &other) const
+{
+    return !(operator>(other));
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+bool SOA_IT_IMP::operator>=(const iteratorImp &other) const
+{
+    return !(operator<(other));
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+SOA_IT_RET &SOA_IT_IMP::operator++()
+{
+    ++m_current;
+    return *this;
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+SOA_IT_RET SOA_IT_IMP::operator++(int)
+{
+    auto temp = *this;
+    ++m_current;
+    return temp;
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+SOA_IT_RET &SOA_IT_IMP::operator--()
+{
+    --m_current;
+    return *this;
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+SOA_IT_RET SOA_IT_IMP::operator--(int)
+{
+    auto temp = *this;
+    --m_current;
+    return temp;
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+SOA_IT_RET &SOA_IT_IMP::operator+=(size_type pos)
+{
+    m_current += pos;
+    return *this;
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+SOA_IT_RET SOA_IT_IMP::operator+(size_type pos) const
+{
+    return iteratorImp(m_owner, m_current + pos);
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+SOA_IT_RET &SOA_IT_IMP::operator-=(size_type pos)
+{
+    m_current -= pos;
+    return *this;
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+SOA_IT_RET SOA_IT_IMP::operator-(size_type pos) const
+{
+    return iteratorImp(m_owner, m_current - pos);
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+typename SOA_IMP::difference_type SOA_IT_IMP::operator-(const iteratorImp &other) const
+{
+    return difference_type(m_current) - difference_type(other.m_current);
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+Reference SOA_IT_IMP::operator*() const
+{
+    return (*m_owner)[m_current];
+}
+
+template<class... Fields>
+template<class Owner, class Reference>
+Reference SOA_IT_IMP::operator[](size_type pos) const
+{
+    return (*m_owner)[m_current + pos];
+}
+
+// imps
+
+template<class... Fields>
+typename SOA_IMP::size_type SoARingBuffer<Fields...>::physical(size_type pos) const
+{
+    return (m_start + pos) % m_capacity;
+}
+
+template<class... Fields>
+template<std::size_t... I>
+void SOA_IMP::allocate_imp(Details::rb_index_sequence<I...>)
+{
+    // every column starts on its own cache line
+    const size_type bytes[] = { sizeof(Fields) * m_capacity... };
+    size_type offsets[sizeof...(Fields)];
+    size_type total = 0;
+    for (size_type column = 0; column < sizeof...(Fields); ++column)
+    {
+        offsets[column] = total;
+        total += (bytes[column] + column_alignment - 1) / column_alignment * column_alignment;
+    }
+
+    m_storage = ::operator new(total + column_alignment);
+    auto base = reinterpret_cast<std::uintptr_t>(m_storage);
+    base = (base + column_alignment - 1) & ~std::uintptr_t(column_alignment - 1);
+
+    m_columns = std::tuple<Fields*...>(reinterpret_cast<Fields*>(base + offsets[I])...);
+}
+
+template<class... Fields>
+template<class Row, std::size_t... I>
+void SOA_IMP::construct_row_imp(size_type pos, Row &&row, Details::rb_index_sequence<I...>)
+{
+    int expand[] = { 0, (new (std::get<I>(m_columns) + pos) Fields(std::get<I>(std::forward<Row>(row))), 0)... };
+    (void)expand;
+}
+
+template<class... Fields>
+template<std::size_t... I>
+void SOA_IMP::destroy_row_imp(size_type pos, Details::rb_index_sequence<I...>)
+{
+    int expand[] = { 0, (std::get<I>(m_columns)[pos].~Fields(), 0)... };
+    (void)expand;
+}
+
+template<class... Fields>
+template<std::size_t... I>
+typename SOA_IMP::reference SoARingBuffer<Fields...>::row_imp(size_type pos, Details::rb_index_sequence<I...>)
+{
+    return reference(std::get<I>(m_columns)[pos]...);
+}
+
+template<class... Fields>
+template<std::size_t... I>
+typename SOA_IMP::const_reference SoARingBuffer<Fields...>::row_imp(size_type pos, Details::rb_index_sequence<I...>) const
+{
+    return const_reference(std::get<I>(m_columns)[pos]...);
+}
+
+template<class... Fields>
+template<class Row>
+void SOA_IMP::push_back_imp(Row &&row)
+{
+    if (m_size < m_capacity)
+    {
+        construct_row_imp(physical(m_size), std::forward<Row>(row), indices());
+        ++m_size;
+        return;
+    }
+
+    destroy_row_imp(m_start, indices());
+    construct_row_imp(m_start, std::forward<Row>(row), indices());
+    m_start = (m_start + 1) % m_capacity;
+}
+
+#undef SOA_IMP
+#undef SOA_IT_IMP
+#undef SOA_IT_RET
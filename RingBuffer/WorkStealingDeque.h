@@ -0,0 +1,74 @@
+//
+//  WorkStealingDeque.h
+//  RingBuffer
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#ifndef WorkStealingDeque_h
+#define WorkStealingDeque_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Chase-Lev work stealing deque (the weak memory model version by Le et al.).
+// The owning thread pushes and pops at the bottom with plain loads and
+// stores plus one fence in pop_bottom; other threads steal from the top
+// with a single CAS. The circular array doubles when full, replaced arrays
+// are kept until destruction because thieves may still read them.
+template<class T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable<T>::value, "slots are read racily by thieves, T must be trivially copyable");
+
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    // capacity is rounded up to a power of two
+    explicit WorkStealingDeque(size_type capacity = 64);
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    // owner thread only
+    void push_bottom(const T &value);
+    bool pop_bottom(T &value);
+
+    // any thread; false when empty or when another thread won the race
+    bool steal(T &value);
+
+    // exact only when no other thread is active
+    size_type size() const;
+    bool empty() const;
+    size_type capacity() const;
+
+private:
+    struct array
+    {
+        explicit array(size_type capacity);
+
+        T load(std::int64_t pos) const;
+        void store(std::int64_t pos, const T &value);
+
+        size_type m_mask;
+        std::unique_ptr<std::atomic<T>[]> m_slots;
+    };
+
+    array *grow(array *current, std::int64_t top, std::int64_t bottom);
+
+// data
+private:
+    alignas(64) std::atomic<std::int64_t> m_top;
+    alignas(64) std::atomic<std::int64_t> m_bottom;
+    std::atomic<array *> m_array;
+    // owner only, every array ever used
+    std::vector<std::unique_ptr<array>> m_arrays;
+};
+
+#include "WorkStealingDeque.hpp"
+
+#endif /* WorkStealingDeque_h */
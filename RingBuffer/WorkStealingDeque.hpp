@@ -0,0 +1,130 @@
+#include "WorkStealingDeque.h"
+
+#define WSD_IMP WorkStealingDeque<T>
+
+template<class T>
+WSD_IMP::array::array(size_type capacity)
+    : m_mask(capacity - 1)
+    , m_slots(new std::atomic<T>[capacity])
+{
+}
+
+template<class T>
+T WSD_IMP::array::load(std::int64_t pos) const
+{
+    return m_slots[pos & m_mask].load(std::memory_order_relaxed);
+}
+
+template<class T>
+void WSD_IMP::array::store(std::int64_t pos, const T &value)
+{
+    m_slots[pos & m_mask].store(value, std::memory_order_relaxed);
+}
+
+template<class T>
+WSD_IMP::WorkStealingDeque(size_type capacity)
+    : m_top(0)
+    , m_bottom(0)
+{
+    size_type rounded = 1;
+    while (rounded < capacity)
+        rounded *= 2;
+
+    m_arrays.emplace_back(new array(rounded));
+    m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+}
+
+template<class T>
+void WSD_IMP::push_bottom(const T &value)
+{
+    auto bottom = m_bottom.load(std::memory_order_relaxed);
+    auto top = m_top.load(std::memory_order_acquire);
+    auto current = m_array.load(std::memory_order_relaxed);
+
+    if (bottom - top > std::int64_t(current->m_mask))
+        current = grow(current, top, bottom);
+
+    current->store(bottom, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template<class T>
+bool WSD_IMP::pop_bottom(T &value)
+{
+    auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    auto current = m_array.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    // orders the bottom reservation before reading top, against thieves
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    value = current->load(bottom);
+    if (top < bottom)
+        return true;
+
+    // last element, race the thieves for it
+    bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+}
+
+template<class T>
+bool WSD_IMP::steal(T &value)
+{
+    auto top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto bottom = m_bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+        return false;
+
+    auto current = m_array.load(std::memory_order_acquire);
+    T stolen = current->load(top);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+
+    value = stolen;
+    return true;
+}
+
+template<class T>
+typename WSD_IMP::size_type WorkStealingDeque<T>::size() const
+{
+    auto bottom = m_bottom.load(std::memory_order_relaxed);
+    auto top = m_top.load(std::memory_order_relaxed);
+    return bottom > top ? size_type(bottom - top) : 0;
+}
+
+template<class T>
+bool WSD_IMP::empty() const
+{
+    return size() == 0;
+}
+
+template<class T>
+typename WSD_IMP::size_type WorkStealingDeque<T>::capacity() const
+{
+    return m_array.load(std::memory_order_relaxed)->m_mask + 1;
+}
+
+template<class T>
+typename WSD_IMP::array *WorkStealingDeque<T>::grow(array *current, std::int64_t top, std::int64_t bottom)
+{
+    m_arrays.emplace_back(new array(2 * (current->m_mask + 1)));
+    array *grown = m_arrays.back().get();
+
+    for (auto pos = top; pos < bottom; ++pos)
+        grown->store(pos, current->load(pos));
+
+    m_array.store(grown, std::memory_order_release);
+    return grown;
+}
+
+#undef WSD_IMP
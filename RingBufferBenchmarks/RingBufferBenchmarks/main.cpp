@@ -0,0 +1,723 @@
+//
+//  main.cpp
+//  RingBufferBenchmarks
+//
+//  Created by Aleksander Konstantinov on 10/19/26.
+//  Copyright © 2026 Aleksander Konstantinov. All rights reserved.
+//
+
+#include <RingBuffer.h>
+#include <SeqlockRingBuffer.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+#include <pthread.h>
+#endif
+
+#if defined(__SANITIZE_THREAD__)
+#define RB_BENCH_TSAN 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define RB_BENCH_TSAN 1
+#endif
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+struct Options
+{
+    double seconds = 2.0;
+    std::size_t threads = 4;        // upper bound of the 1->N and N->1 sweeps
+    std::size_t capacity = 1024;
+    std::size_t burst = 4096;
+    bool blocking = false;          // condition variables instead of spinning
+    std::vector<int> cpus;          // thread i runs on cpus[i % cpus.size()]
+};
+
+// Pins the calling thread, index counts the threads of one scenario.
+// On macOS it is only an affinity hint, threads with different tags
+// are kept apart.
+static void pinThread(const Options &options, std::size_t index)
+{
+    if (options.cpus.empty())
+        return;
+
+    int cpu = options.cpus[index % options.cpus.size()];
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(__APPLE__)
+    thread_affinity_policy_data_t policy = { cpu + 1 };
+    thread_policy_set
+        (
+            pthread_mach_thread_np(pthread_self())
+            , THREAD_AFFINITY_POLICY
+            , reinterpret_cast<thread_policy_t>(&policy)
+            , THREAD_AFFINITY_POLICY_COUNT
+        );
+#else
+    (void)cpu;
+#endif
+}
+
+static std::uint64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+static void printLatencies(const char *label, std::vector<std::uint64_t> &samples, double opsPerSecond)
+{
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double q) -> double {
+        if (samples.empty())
+            return 0.0;
+        std::size_t pos = std::min(samples.size() - 1, std::size_t(q * samples.size()));
+        return double(samples[pos]);
+    };
+
+    std::printf
+        (
+            "  %-24s %12.0f ops/s  p50 %8.0f ns  p99 %8.0f ns  p99.9 %9.0f ns\n"
+            , label
+            , opsPerSecond
+            , percentile(0.5)
+            , percentile(0.99)
+            , percentile(0.999)
+        );
+}
+
+// RingBuffer guarded by a mutex, the way it is shared between threads today.
+// Waits either by spinning with yield or on condition variables.
+template<class T>
+class LockedRing
+{
+public:
+    LockedRing(std::size_t capacity, bool blocking)
+        : m_buffer(capacity)
+        , m_blocking(blocking)
+        , m_stalls(0)
+    {
+    }
+
+    void push(T value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_buffer.size() == m_buffer.capacity())
+        {
+            ++m_stalls;
+            while (m_buffer.size() == m_buffer.capacity())
+                wait(lock, m_notFull);
+        }
+
+        m_buffer.push_back(std::move(value));
+        if (m_blocking)
+            m_notEmpty.notify_one();
+    }
+
+    // overwrites the oldest element instead of waiting
+    void overwrite(T value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_buffer.push_back(std::move(value));
+        if (m_blocking)
+            m_notEmpty.notify_one();
+    }
+
+    T pop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (m_buffer.empty())
+            wait(lock, m_notEmpty);
+
+        T value = std::move(m_buffer.front());
+        m_buffer.pop_front();
+        if (m_blocking)
+            m_notFull.notify_one();
+        return value;
+    }
+
+    bool try_pop(T &value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_buffer.empty())
+            return false;
+
+        value = std::move(m_buffer.front());
+        m_buffer.pop_front();
+        if (m_blocking)
+            m_notFull.notify_one();
+        return true;
+    }
+
+    // copy of the whole content, exercises the copy constructor under load
+    RingBuffer<T> snapshot()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_buffer;
+    }
+
+    std::size_t stalls() const
+    {
+        return m_stalls;
+    }
+
+private:
+    void wait(std::unique_lock<std::mutex> &lock, std::condition_variable &condition)
+    {
+        if (m_blocking)
+        {
+            condition.wait(lock);
+            return;
+        }
+
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    RingBuffer<T> m_buffer;
+    bool m_blocking;
+    std::size_t m_stalls;
+};
+
+static const std::uint64_t stopToken = ~std::uint64_t(0);
+
+// streaming stores
+
+struct LargeElement
+{
+    unsigned char bytes[1024];
+};
+
+// Sums a working set sized for L2, the "hot" workload sharing the core.
+class Victim
+{
+public:
+    explicit Victim(std::size_t bytes)
+        : m_data(bytes / sizeof(unsigned), 1)
+    {
+    }
+
+    // one pass over the working set, returns its duration in ns
+    std::uint64_t pass()
+    {
+        auto begin = nowNs();
+        unsigned sum = 0;
+        for (auto value : m_data)
+            sum += value;
+        m_sink = sum;
+        return nowNs() - begin;
+    }
+
+private:
+    std::vector<unsigned> m_data;
+    volatile unsigned m_sink = 0;
+};
+
+// Pushes large elements into a ring far bigger than the last level cache,
+// either one push_back per element or one append per batch.
+class Producer
+{
+public:
+    Producer(bool streaming, bool bulk)
+        : m_buffer((256u << 20) / sizeof(LargeElement))
+        , m_batch(256)
+        , m_bulk(bulk)
+    {
+        for (std::size_t pos = 0; pos < m_batch.size(); ++pos)
+            std::memset(m_batch[pos].bytes, int(pos), sizeof(m_batch[pos].bytes));
+
+        // touch every page once, so the timed rounds don't pay for faults
+        while (m_buffer.push_count() < m_buffer.capacity())
+            m_buffer.append(m_batch.data(), m_batch.size());
+        m_buffer.set_streaming_stores(streaming);
+    }
+
+    // one batch, returns its duration in ns
+    std::uint64_t round()
+    {
+        auto begin = nowNs();
+        if (m_bulk)
+            m_buffer.append(m_batch.data(), m_batch.size());
+        else
+        {
+            for (const auto &element : m_batch)
+                m_buffer.push_back(element);
+        }
+        return nowNs() - begin;
+    }
+
+    std::size_t roundBytes() const
+    {
+        return m_batch.size() * sizeof(LargeElement);
+    }
+
+private:
+    RingBuffer<LargeElement> m_buffer;
+    std::vector<LargeElement> m_batch;
+    bool m_bulk;
+};
+
+// The victim and the producer alternate on one pinned thread, so what the
+// ring writes evict from the caches is exactly what the victim needs next.
+static void streamingScenario(const Options &options)
+{
+    std::printf("streaming: L2-resident workload alternating with a 1KB element producer on one core\n");
+    pinThread(options, 0);
+
+    double alone = 0;
+    {
+        Victim victim(512 << 10);
+        std::uint64_t total = 0;
+        std::uint64_t passes = 0;
+        auto deadline = Clock::now() + std::chrono::duration<double>(options.seconds);
+        while (Clock::now() < deadline)
+        {
+            total += victim.pass();
+            ++passes;
+        }
+        alone = double(total) / passes;
+    }
+    std::printf("  victim alone             %10.0f ns/pass\n", alone);
+
+    for (int bulk = 0; bulk < 2; ++bulk)
+    {
+        for (int streaming = 0; streaming < 2; ++streaming)
+        {
+            Victim victim(512 << 10);
+            Producer producer(streaming != 0, bulk != 0);
+
+            std::uint64_t victimNs = 0;
+            std::uint64_t producerNs = 0;
+            std::uint64_t rounds = 0;
+            auto deadline = Clock::now() + std::chrono::duration<double>(options.seconds);
+            while (Clock::now() < deadline)
+            {
+                victimNs += victim.pass();
+                producerNs += producer.round();
+                ++rounds;
+            }
+
+            double perPass = double(victimNs) / rounds;
+            double throughput = double(rounds) * producer.roundBytes() / (producerNs * 1e-9) / (1 << 30);
+            std::printf
+                (
+                    "  %-9s %-9s stores %10.0f ns/pass  slowdown %5.1f%%  producer %6.2f GiB/s\n"
+                    , bulk ? "append" : "push_back"
+                    , streaming ? "streaming" : "regular"
+                    , perPass
+                    , 100.0 * (perPass / alone - 1.0)
+                    , throughput
+                );
+        }
+    }
+}
+
+// concurrency
+
+static void pingPongScenario(const Options &options)
+{
+    std::printf("pingpong: SPSC round trip through two rings (%s)\n", options.blocking ? "blocking" : "spinning");
+
+    LockedRing<std::uint64_t> requests(options.capacity, options.blocking);
+    LockedRing<std::uint64_t> responses(options.capacity, options.blocking);
+    std::vector<std::uint64_t> samples;
+
+    std::thread echo([&]() {
+        pinThread(options, 1);
+        for (;;)
+        {
+            auto value = requests.pop();
+            responses.push(value);
+            if (value == stopToken)
+                return;
+        }
+    });
+
+    pinThread(options, 0);
+    auto begin = Clock::now();
+    auto deadline = begin + std::chrono::duration<double>(options.seconds);
+    while (Clock::now() < deadline)
+    {
+        auto sent = nowNs();
+        requests.push(sent);
+        responses.pop();
+        samples.push_back(nowNs() - sent);
+    }
+    requests.push(stopToken);
+    responses.pop();
+    echo.join();
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+    printLatencies("round trip", samples, samples.size() / elapsed);
+}
+
+// producers push timestamps, consumers measure their age when popped
+static void runTransfer
+    (
+        const Options &options
+        , std::size_t producers
+        , std::size_t consumers
+        , const char *label
+    )
+{
+    LockedRing<std::uint64_t> ring(options.capacity, options.blocking);
+    std::vector<std::vector<std::uint64_t>> samples(consumers);
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> popped(0);
+    std::atomic<bool> start(false);
+
+    for (std::size_t consumer = 0; consumer < consumers; ++consumer)
+    {
+        threads.emplace_back([&, consumer]() {
+            pinThread(options, producers + consumer);
+            std::size_t count = 0;
+            for (;;)
+            {
+                auto value = ring.pop();
+                if (value == stopToken)
+                    break;
+                // sample one element out of 16 to keep the recording cheap
+                if ((++count & 15) == 0)
+                    samples[consumer].push_back(nowNs() - value);
+            }
+            popped += count;
+        });
+    }
+
+    for (std::size_t producer = 0; producer < producers; ++producer)
+    {
+        threads.emplace_back([&, producer]() {
+            pinThread(options, producer);
+            while (!start.load())
+                std::this_thread::yield();
+
+            auto deadline = Clock::now() + std::chrono::duration<double>(options.seconds);
+            while (Clock::now() < deadline)
+            {
+                for (int pos = 0; pos < 64; ++pos)
+                    ring.push(nowNs());
+            }
+        });
+    }
+
+    auto begin = Clock::now();
+    start = true;
+    for (std::size_t producer = 0; producer < producers; ++producer)
+        threads[consumers + producer].join();
+    for (std::size_t consumer = 0; consumer < consumers; ++consumer)
+        ring.push(stopToken);
+    for (std::size_t consumer = 0; consumer < consumers; ++consumer)
+        threads[consumer].join();
+    double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    std::vector<std::uint64_t> merged;
+    for (const auto &part : samples)
+        merged.insert(merged.end(), part.begin(), part.end());
+    printLatencies(label, merged, popped.load() / elapsed);
+}
+
+static void fanOutScenario(const Options &options)
+{
+    std::printf("fanout: 1 producer -> N consumers, capacity %zu (%s)\n", options.capacity, options.blocking ? "blocking" : "spinning");
+    for (std::size_t consumers = 1; consumers <= options.threads; consumers *= 2)
+    {
+        std::string label = "1 -> " + std::to_string(consumers);
+        runTransfer(options, 1, consumers, label.c_str());
+    }
+}
+
+static void fanInScenario(const Options &options)
+{
+    std::printf("fanin: N producers -> 1 consumer, capacity %zu (%s)\n", options.capacity, options.blocking ? "blocking" : "spinning");
+    for (std::size_t producers = 1; producers <= options.threads; producers *= 2)
+    {
+        std::string label = std::to_string(producers) + " -> 1";
+        runTransfer(options, producers, 1, label.c_str());
+    }
+}
+
+static void burstScenario(const Options &options)
+{
+    std::printf
+        (
+            "burst: bursts of %zu into capacity %zu, 1ms apart (%s)\n"
+            , options.burst
+            , options.capacity
+            , options.blocking ? "blocking" : "spinning"
+        );
+
+    LockedRing<std::uint64_t> ring(options.capacity, options.blocking);
+    std::vector<std::uint64_t> samples;
+    std::size_t popped = 0;
+
+    std::thread consumer([&]() {
+        pinThread(options, 1);
+        for (;;)
+        {
+            auto value = ring.pop();
+            if (value == stopToken)
+                return;
+            samples.push_back(nowNs() - value);
+            ++popped;
+        }
+    });
+
+    pinThread(options, 0);
+    auto begin = Clock::now();
+    auto deadline = begin + std::chrono::duration<double>(options.seconds);
+    std::size_t bursts = 0;
+    while (Clock::now() < deadline)
+    {
+        for (std::size_t pos = 0; pos < options.burst; ++pos)
+            ring.push(nowNs());
+        ++bursts;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ring.push(stopToken);
+    consumer.join();
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+    printLatencies("burst", samples, popped / elapsed);
+    std::printf("  %zu bursts, producer blocked on a full ring %zu times\n", bursts, ring.stalls());
+}
+
+// stress
+
+struct StressSample
+{
+    std::uint64_t sequence;
+    std::uint64_t check;
+};
+
+// Hammers the rings from several threads, meant to run for minutes in
+// a -fsanitize=thread or -fsanitize=address build. Returns failed checks.
+static std::size_t runStress(const Options &options)
+{
+    std::atomic<bool> stop(false);
+    std::atomic<std::size_t> failures(0);
+    std::atomic<std::size_t> operations(0);
+    std::vector<std::thread> threads;
+    const std::size_t producers = 2;
+
+    // push/pop with backpressure, the consumer checks per producer order
+    LockedRing<std::string> queue(8, options.blocking);
+    for (std::size_t producer = 0; producer < producers; ++producer)
+    {
+        threads.emplace_back([&, producer]() {
+            pinThread(options, producer);
+            for (std::uint64_t sequence = 0; !stop.load(); ++sequence)
+                queue.push(std::to_string(producer) + ":" + std::to_string(sequence) + std::string(sequence % 40, 'x'));
+            queue.push(std::string());
+        });
+    }
+    threads.emplace_back([&]() {
+        pinThread(options, producers);
+        std::vector<long long> last(producers, -1);
+        for (std::size_t finished = 0; finished < producers;)
+        {
+            auto value = queue.pop();
+            if (value.empty())
+            {
+                ++finished;
+                continue;
+            }
+
+            std::istringstream stream(value);
+            std::size_t producer = 0;
+            long long sequence = 0;
+            char separator = 0;
+            stream >> producer >> separator >> sequence;
+            if (producer >= producers || sequence != last[producer] + 1)
+                ++failures;
+            else
+                last[producer] = sequence;
+            ++operations;
+        }
+    });
+
+    // full ring overwrite against concurrent pops and copies
+    LockedRing<std::string> overwritten(16, false);
+    threads.emplace_back([&]() {
+        pinThread(options, producers + 1);
+        for (std::uint64_t sequence = 0; !stop.load(); ++sequence)
+        {
+            overwritten.overwrite(std::string(sequence % 64, 'o'));
+            ++operations;
+        }
+    });
+    threads.emplace_back([&]() {
+        pinThread(options, producers + 2);
+        std::string value;
+        while (!stop.load())
+        {
+            if (overwritten.try_pop(value) && value.find_first_not_of('o') != std::string::npos)
+                ++failures;
+
+            auto copy = overwritten.snapshot();
+            if (copy.size() > copy.capacity())
+                ++failures;
+            ++operations;
+        }
+    });
+
+#ifndef RB_BENCH_TSAN
+    // seqlock readers copy slots racing with the writer by design, which
+    // thread sanitizer reports, so this part only runs in other builds
+    SeqlockRingBuffer<StressSample> latest(64);
+    threads.emplace_back([&]() {
+        pinThread(options, producers + 3);
+        for (std::uint64_t sequence = 0; !stop.load(); ++sequence)
+            latest.push_back(StressSample{sequence, ~sequence});
+    });
+    threads.emplace_back([&]() {
+        pinThread(options, producers + 4);
+        StressSample out[16];
+        while (!stop.load())
+        {
+            auto count = latest.read_latest(out, 16);
+            for (std::size_t pos = 0; pos < count; ++pos)
+            {
+                if (out[pos].check != ~out[pos].sequence
+                    || (pos > 0 && out[pos].sequence != out[pos - 1].sequence + 1))
+                    ++failures;
+            }
+            ++operations;
+        }
+    });
+#endif
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.seconds));
+    stop = true;
+    for (auto &thread : threads)
+        thread.join();
+
+    std::printf("  %zu operations, %zu failed checks\n", operations.load(), failures.load());
+    return failures.load();
+}
+
+static int stressFailures = 0;
+
+static void stressScenario(const Options &options)
+{
+    std::printf("stress: push/pop/overwrite/seqlock hammering for %.0f s\n", options.seconds);
+    if (runStress(options))
+        stressFailures = 1;
+}
+
+struct Scenario
+{
+    const char *name;
+    void (*run)(const Options &);
+    bool byDefault;
+};
+
+static const Scenario scenarios[] = {
+    {"streaming", streamingScenario, true},
+    {"pingpong", pingPongScenario, true},
+    {"fanout", fanOutScenario, true},
+    {"fanin", fanInScenario, true},
+    {"burst", burstScenario, true},
+    {"stress", stressScenario, false},
+};
+
+static void usage()
+{
+    std::printf
+        (
+            "usage: RingBufferBenchmarks [options] [scenario...]\n"
+            "  --seconds N     duration of every run, use minutes for stress\n"
+            "  --threads N     largest producer/consumer count of the sweeps\n"
+            "  --capacity N    ring capacity\n"
+            "  --burst N       elements per burst\n"
+            "  --cpus a,b,...  pin thread i of a scenario to the i-th listed cpu\n"
+            "  --blocking      wait on condition variables instead of spinning\n"
+            "scenarios:"
+        );
+    for (const auto &scenario : scenarios)
+        std::printf(" %s%s", scenario.name, scenario.byDefault ? "" : "(*)");
+    std::printf("\n(*) only when named\n");
+}
+
+static std::vector<int> parseCpus(const std::string &list)
+{
+    std::vector<int> cpus;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        cpus.push_back(std::atoi(item.c_str()));
+    return cpus;
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    std::vector<std::string> selected;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        std::string value = argv[arg];
+        bool hasNext = arg + 1 < argc;
+        if (value == "--seconds" && hasNext)
+            options.seconds = std::atof(argv[++arg]);
+        else if (value == "--threads" && hasNext)
+            options.threads = std::max(1, std::atoi(argv[++arg]));
+        else if (value == "--capacity" && hasNext)
+            options.capacity = std::max(1, std::atoi(argv[++arg]));
+        else if (value == "--burst" && hasNext)
+            options.burst = std::max(1, std::atoi(argv[++arg]));
+        else if (value == "--cpus" && hasNext)
+            options.cpus = parseCpus(argv[++arg]);
+        else if (value == "--blocking")
+            options.blocking = true;
+        else if (value == "--help")
+        {
+            usage();
+            return 0;
+        }
+        else
+            selected.push_back(value);
+    }
+
+    bool ran = false;
+    for (const auto &scenario : scenarios)
+    {
+        bool wanted = selected.empty() && scenario.byDefault;
+        for (const auto &name : selected)
+            wanted = wanted || name == scenario.name;
+
+        if (wanted)
+        {
+            scenario.run(options);
+            ran = true;
+        }
+    }
+
+    if (!ran)
+    {
+        usage();
+        return 1;
+    }
+    return stressFailures;
+}
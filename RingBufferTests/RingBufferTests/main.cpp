@@ -11,6 +11,30 @@
 #include <RingBuffer.h>
 #include <gtest/gtest.h>
 
+#include <AsyncRingBuffer.h>
+#include <RingBufferSerialization.h>
+#include <SeqlockRingBuffer.h>
+#include <SoARingBuffer.h>
+#include <ChunkedRingBuffer.h>
+#include <WorkStealingDeque.h>
+#include <OrderStatisticRingBuffer.h>
+#include <DedupeRingBuffer.h>
+#include <RingBufferIO.h>
+#include <CompressedRingBuffer.h>
+#include <RingBufferParallel.h>
+#include <FrameRingBuffer.h>
+#include <PriorityRingBuffer.h>
+#include <iterator>
+#include <numeric>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <deque>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <atomic>
+
 class TestableWithoutCoppyAssign
 {
 public:
@@ -208,6 +232,1064 @@ TEST (RingBuffer, behaviourTests) {
     EXPECT_EQ(TestableWithoutCoppyAssign::getDestructs(), 3 * elemsSize);
 }
 
+TEST (RingBuffer, segmentsTests) {
+    RingBuffer<int> rb(4);
+    for (int i = 1; i <= 6; ++i)
+        rb.push_back(i);
+    
+    auto one = rb.array_one();
+    auto two = rb.array_two();
+    EXPECT_EQ(one.second, 2);
+    EXPECT_EQ(two.second, 2);
+    EXPECT_EQ(one.first[0], 3);
+    EXPECT_EQ(two.first[1], 6);
+    EXPECT_EQ(rb.push_count(), 6);
+}
+
+struct StringCodec
+{
+    void write(std::ostream &os, const std::string &value)
+    {
+        os << value.size() << ' ' << value;
+    }
+    
+    std::string read(std::istream &is)
+    {
+        std::size_t size = 0;
+        is >> size;
+        is.get();
+        std::string value(size, '\0');
+        is.read(&value[0], size);
+        return value;
+    }
+};
+
+TEST (RingBuffer, bulkTests) {
+    RingBuffer<int> rb(5);
+    int values[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    rb.append(values, 3);
+    rb.append(values + 3, 4);
+    EXPECT_EQ(rb.size(), 5);
+    EXPECT_EQ(rb.front(), 3);
+    EXPECT_EQ(rb.back(), 7);
+    EXPECT_EQ(rb.push_count(), 7);
+    
+    rb.append(values, 8);
+    EXPECT_EQ(rb.front(), 4);
+    
+    int out[8] = {};
+    EXPECT_EQ(rb.pop_front(out, 2), 2);
+    EXPECT_EQ(out[1], 5);
+    EXPECT_EQ(rb.pop_front(out, 8), 3);
+    EXPECT_EQ(out[2], 8);
+    EXPECT_TRUE(rb.empty());
+    
+    TestableWithoutCoppyAssign::reset();
+    {
+        RingBuffer<TestableWithoutCoppyAssign> objects(2);
+        objects.set_streaming_stores(true);
+        EXPECT_FALSE(objects.streaming_stores());
+        TestableWithoutCoppyAssign items[] = {
+            TestableWithoutCoppyAssign(1), TestableWithoutCoppyAssign(2), TestableWithoutCoppyAssign(3)
+        };
+        objects.append(items, 3);
+        EXPECT_EQ(objects.front().getVal(), 2);
+    }
+    EXPECT_EQ(TestableWithoutCoppyAssign::getCounter(), 0);
+}
+
+struct LargeElement
+{
+    int id;
+    unsigned char payload[1020];
+};
+
+TEST (RingBuffer, streamingTests) {
+    RingBuffer<LargeElement> rb(7);
+    rb.set_streaming_stores(true);
+    EXPECT_TRUE(rb.streaming_stores());
+    
+    std::vector<LargeElement> items(10);
+    for (int i = 0; i < 10; ++i)
+    {
+        items[i].id = i;
+        std::fill(std::begin(items[i].payload), std::end(items[i].payload), static_cast<unsigned char>(i));
+    }
+    
+    rb.push_back(items[0]);
+    rb.append(items.data() + 1, 9);
+    EXPECT_EQ(rb.size(), 7);
+    EXPECT_EQ(rb.front().id, 3);
+    
+    RingBuffer<LargeElement> copy = rb;
+    EXPECT_TRUE(copy.streaming_stores());
+    
+    copy.reallocate(9);
+    EXPECT_EQ(copy.capacity(), 9);
+    EXPECT_TRUE(copy.streaming_stores());
+    EXPECT_EQ(copy.push_count(), 10);
+    
+    std::vector<LargeElement> out(7);
+    EXPECT_EQ(rb.pop_front(out.data(), 7), 7);
+    for (int i = 0; i < 7; ++i)
+    {
+        EXPECT_EQ(out[i].id, i + 3);
+        EXPECT_EQ(out[i].payload[1019], i + 3);
+    }
+}
+
+TEST (ChunkedRingBuffer, growShrinkTests) {
+    ChunkedRingBuffer<int> rb(4, 1);
+    EXPECT_EQ(rb.capacity(), 0);
+    EXPECT_THROW(rb.pop_front(), std::range_error);
+    
+    for (int i = 0; i < 100; ++i)
+        rb.push_back(i);
+    EXPECT_EQ(rb.size(), 100);
+    EXPECT_EQ(rb.capacity(), 100);
+    EXPECT_EQ(rb.front(), 0);
+    EXPECT_EQ(rb.back(), 99);
+    EXPECT_EQ(rb[57], 57);
+    
+    for (int i = 0; i < 98; ++i)
+        rb.pop_front();
+    EXPECT_EQ(rb.front(), 98);
+    EXPECT_EQ(rb.capacity(), 4);
+    EXPECT_EQ(rb.pooled_blocks(), 1);
+    
+    rb.push_back(100);
+    rb.push_back(101);
+    rb.push_back(102);
+    EXPECT_EQ(rb.pooled_blocks(), 0);
+    EXPECT_EQ(rb.capacity(), 8);
+    
+    auto it = rb.begin();
+    EXPECT_EQ(*it, 98);
+    EXPECT_EQ(it[4], 102);
+    EXPECT_EQ(rb.end() - rb.begin(), 5);
+    EXPECT_EQ(std::find(rb.begin(), rb.end(), 101) - rb.begin(), 3);
+    
+    auto last = rb.end() - 1;
+    EXPECT_TRUE(last > it);
+    EXPECT_TRUE(it <= it);
+    EXPECT_TRUE(last >= it + 4);
+    EXPECT_EQ(*(2 + it), 100);
+    
+    rb.clear();
+    EXPECT_EQ(rb.capacity(), 0);
+    rb.shrink_to_fit();
+    EXPECT_EQ(rb.pooled_blocks(), 0);
+}
+
+#if defined(__cpp_lib_concepts)
+static_assert(std::random_access_iterator<ChunkedRingBuffer<int>::iterator>, "chunked ring buffer iterator is random access");
+static_assert(std::random_access_iterator<ChunkedRingBuffer<int>::const_iterator>, "chunked ring buffer iterator is random access");
+#endif
+
+TEST (ChunkedRingBuffer, objectsTests) {
+    TestableWithoutCoppyAssign::reset();
+    {
+        ChunkedRingBuffer<TestableWithoutCoppyAssign> rb(3);
+        for (int i = 0; i < 10; ++i)
+            rb.emplace_back(i, 1);
+        rb.pop_front();
+        EXPECT_EQ(TestableWithoutCoppyAssign::getCounter(), 9);
+        
+        ChunkedRingBuffer<TestableWithoutCoppyAssign> copy = rb;
+        EXPECT_EQ(copy.size(), 9);
+        EXPECT_EQ(copy.front().getVal(), 2);
+        EXPECT_EQ(TestableWithoutCoppyAssign::getCopyConstructs(), 9);
+        
+        ChunkedRingBuffer<TestableWithoutCoppyAssign> moved = std::move(copy);
+        EXPECT_EQ(copy.size(), 0);
+        EXPECT_EQ(moved.back().getVal(), 10);
+        EXPECT_EQ(moved.begin()->getVal(), 2);
+    }
+    EXPECT_EQ(TestableWithoutCoppyAssign::getCounter(), 0);
+}
+
+TEST (WorkStealingDeque, ownerTests) {
+    WorkStealingDeque<int> deque(3);
+    EXPECT_EQ(deque.capacity(), 4);
+    int value = 0;
+    EXPECT_FALSE(deque.pop_bottom(value));
+    EXPECT_FALSE(deque.steal(value));
+    
+    for (int i = 0; i < 10; ++i)
+        deque.push_bottom(i);
+    EXPECT_EQ(deque.size(), 10);
+    EXPECT_EQ(deque.capacity(), 16);
+    
+    EXPECT_TRUE(deque.pop_bottom(value));
+    EXPECT_EQ(value, 9);
+    EXPECT_TRUE(deque.steal(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_EQ(deque.size(), 8);
+    
+    while (deque.pop_bottom(value))
+        ;
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST (WorkStealingDeque, stealTests) {
+    const int items = 100000;
+    WorkStealingDeque<int> deque(16);
+    std::vector<std::atomic<int>> taken(items);
+    for (auto &count : taken)
+        count = 0;
+    std::atomic<bool> done(false);
+    
+    auto thief = [&]() {
+        int value = 0;
+        while (!done.load())
+        {
+            if (deque.steal(value))
+                ++taken[value];
+        }
+        while (deque.steal(value))
+            ++taken[value];
+    };
+    
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; ++i)
+        thieves.emplace_back(thief);
+    
+    int value = 0;
+    for (int i = 0; i < items; ++i)
+    {
+        deque.push_bottom(i);
+        if (i % 3 == 0 && deque.pop_bottom(value))
+            ++taken[value];
+    }
+    while (deque.pop_bottom(value))
+        ++taken[value];
+    done = true;
+    for (auto &thread : thieves)
+        thread.join();
+    
+    int wrong = 0;
+    for (auto &count : taken)
+        wrong += count.load() != 1;
+    EXPECT_EQ(wrong, 0);
+}
+
+TEST (OrderStatisticRingBuffer, windowTests) {
+    OrderStatisticRingBuffer<unsigned> rb(64);
+    EXPECT_THROW(rb.median(), std::range_error);
+    
+    std::mt19937 random(7);
+    for (int step = 0; step < 2000; ++step)
+    {
+        if (random() % 5 == 0 && !rb.empty())
+            rb.pop_front();
+        else
+            rb.push_back(random() % 100);
+        
+        if (rb.empty())
+            continue;
+        
+        std::vector<unsigned> window(rb.begin(), rb.end());
+        std::sort(window.begin(), window.end());
+        auto k = random() % window.size();
+        ASSERT_EQ(rb.nth_smallest(k), window[k]);
+        ASSERT_EQ(rb.median(), window[(window.size() - 1) / 2]);
+        ASSERT_EQ(rb.rank(50), std::size_t(std::lower_bound(window.begin(), window.end(), 50u) - window.begin()));
+    }
+}
+
+TEST (OrderStatisticRingBuffer, quantileTests) {
+    OrderStatisticRingBuffer<int, std::greater<int>> rb(100);
+    for (int i = 1; i <= 250; ++i)
+        rb.push_back(i);
+    
+    // window is 151..250 sorted descending
+    EXPECT_EQ(rb.size(), 100);
+    EXPECT_EQ(rb.quantile(0.0), 250);
+    EXPECT_EQ(rb.quantile(0.01), 250);
+    EXPECT_EQ(rb.quantile(0.5), 201);
+    EXPECT_EQ(rb.quantile(0.99), 152);
+    EXPECT_EQ(rb.quantile(1.0), 151);
+    EXPECT_THROW(rb.nth_smallest(100), std::range_error);
+}
+
+TEST (DedupeRingBuffer, fullTests) {
+    DedupeRingBuffer<int> rb(3);
+    EXPECT_TRUE(rb.insert(1));
+    EXPECT_TRUE(rb.insert(2));
+    EXPECT_FALSE(rb.insert(1));
+    EXPECT_TRUE(rb.insert(3));
+    EXPECT_EQ(rb.size(), 3);
+    
+    // 1 is evicted by 4
+    EXPECT_TRUE(rb.insert(4));
+    EXPECT_FALSE(rb.contains(1));
+    EXPECT_TRUE(rb.contains(2));
+    EXPECT_TRUE(rb.insert(1));
+    EXPECT_EQ(rb.front(), 3);
+    
+    rb.pop_front();
+    EXPECT_FALSE(rb.contains(3));
+    rb.clear();
+    EXPECT_TRUE(rb.empty());
+    EXPECT_FALSE(rb.contains(4));
+}
+
+TEST (DedupeRingBuffer, collisionTests) {
+    // every value hashes alike, so all of them share one probe chain
+    struct CollidingHash { std::size_t operator()(int value) const { return value % 4; } };
+    DedupeRingBuffer<int, CollidingHash> rb(16);
+    
+    std::mt19937 random(11);
+    std::deque<int> recent;
+    for (int step = 0; step < 5000; ++step)
+    {
+        int value = random() % 40;
+        bool seen = std::find(recent.begin(), recent.end(), value) != recent.end();
+        ASSERT_EQ(rb.contains(value), seen);
+        ASSERT_EQ(rb.insert(value), !seen);
+        if (!seen)
+        {
+            recent.push_back(value);
+            if (recent.size() > 16)
+                recent.pop_front();
+        }
+        ASSERT_TRUE(std::equal(recent.begin(), recent.end(), rb.begin()));
+    }
+}
+
+TEST (RingBufferIO, pipeTests) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    
+    // move the content across the storage end so both calls need two segments
+    RingBuffer<char> rb(8);
+    const char prefix[] = "xxxxxx";
+    rb.append(prefix, 6);
+    char scratch[6];
+    rb.pop_front(scratch, 6);
+    
+    ASSERT_EQ(write(fds[1], "abcdefghij", 10), 10);
+    EXPECT_EQ(read_from_fd(rb, fds[0], 5), 5);
+    EXPECT_EQ(read_from_fd(rb, fds[0]), 3);
+    EXPECT_EQ(rb.size(), 8);
+    EXPECT_EQ(read_from_fd(rb, fds[0]), -1);
+    EXPECT_EQ(errno, ENOBUFS);
+    EXPECT_EQ(std::string(rb.begin(), rb.end()), "abcdefgh");
+    EXPECT_EQ(rb.push_count(), 14);
+    
+    EXPECT_EQ(write_to_fd(rb, fds[1]), 8);
+    EXPECT_TRUE(rb.empty());
+    EXPECT_EQ(read_from_fd(rb, fds[0]), 8);
+    EXPECT_EQ(std::string(rb.begin(), rb.end()), "ijabcdef");
+    
+    close(fds[1]);
+    rb.clear();
+    EXPECT_EQ(read_from_fd(rb, fds[0]), 2);
+    EXPECT_EQ(read_from_fd(rb, fds[0]), 0);
+    close(fds[0]);
+}
+
+TEST (RingBufferIO, nonblockingSocketTests) {
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+    
+    RingBuffer<unsigned char> rb(1 << 12);
+    EXPECT_EQ(read_from_fd(rb, fds[0]), -1);
+    EXPECT_TRUE(errno == EAGAIN || errno == EWOULDBLOCK);
+    EXPECT_TRUE(rb.empty());
+    
+    // fill the socket until it pushes back, counting what went through
+    std::size_t sent = 0;
+    unsigned char next = 0;
+    for (;;)
+    {
+        while (rb.size() < rb.capacity())
+            rb.push_back(next++);
+        auto written = write_to_fd(rb, fds[1]);
+        if (written < 0)
+        {
+            EXPECT_TRUE(errno == EAGAIN || errno == EWOULDBLOCK);
+            break;
+        }
+        sent += written;
+    }
+    
+    RingBuffer<unsigned char> in(1000);
+    std::size_t received = 0;
+    unsigned char expected = 0;
+    bool ordered = true;
+    for (;;)
+    {
+        auto got = read_from_fd(in, fds[0]);
+        if (got < 0)
+            break;
+        received += got;
+        while (!in.empty())
+        {
+            ordered = ordered && in.front() == expected++;
+            in.pop_front();
+        }
+    }
+    EXPECT_EQ(received, sent);
+    EXPECT_TRUE(ordered);
+    
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST (CompressedRingBuffer, integerTests) {
+    CompressedRingBuffer<std::int64_t> rb(4, 100);
+    EXPECT_THROW(rb.front(), std::range_error);
+    
+    // regular timestamps with jitter, an occasional gap and extreme values
+    std::mt19937 random(5);
+    std::deque<std::int64_t> expected;
+    std::int64_t timestamp = 1700000000000;
+    for (int step = 0; step < 1234; ++step)
+    {
+        timestamp += 1000 + (random() % 10 == 0 ? std::int64_t(random() % 5) - 2 : 0);
+        if (step % 300 == 299)
+            timestamp += 1000000000;
+        std::int64_t value = step == 777 ? INT64_MIN : step == 778 ? INT64_MAX : timestamp;
+        rb.push_back(value);
+        expected.push_back(value);
+        
+        while (expected.size() > rb.size())
+            expected.pop_front();
+    }
+    
+    // 4 full blocks and 34 plain values
+    EXPECT_EQ(rb.size(), 434);
+    EXPECT_EQ(rb.front(), expected.front());
+    EXPECT_EQ(rb.back(), expected.back());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), rb.begin()));
+    
+    for (std::size_t skip : { 0, 1, 99, 100, 101, 250, 400, 433 })
+        EXPECT_EQ(*(rb.begin() + skip), expected[skip]);
+    auto it = rb.begin() + 50;
+    it += 120;
+    EXPECT_EQ(*it, expected[170]);
+    EXPECT_TRUE(rb.begin() + 434 == rb.end());
+    
+    rb.clear();
+    EXPECT_TRUE(rb.empty());
+    EXPECT_TRUE(rb.begin() == rb.end());
+}
+
+TEST (CompressedRingBuffer, floatingTests) {
+    CompressedRingBuffer<double> prices(8, 512);
+    CompressedRingBuffer<float> levels(2, 64);
+    
+    std::mt19937 random(9);
+    std::vector<double> expected;
+    double price = 101.25;
+    for (int step = 0; step < 8 * 512; ++step)
+    {
+        if (random() % 8 == 0)
+            price += (int(random() % 9) - 4) * 0.25;
+        prices.push_back(price);
+        expected.push_back(price);
+        levels.push_back(float(step % 7) * 0.5f);
+    }
+    
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), prices.begin()));
+    EXPECT_LT(prices.memory_usage() * 5, expected.size() * sizeof(double));
+    
+    std::size_t pos = levels.size();
+    for (auto level : levels)
+        EXPECT_EQ(level, float((8 * 512 - pos--) % 7) * 0.5f);
+}
+
+TEST (CompressedRingBuffer, compressionTests) {
+    CompressedRingBuffer<std::int64_t> rb(16, 1024);
+    for (std::int64_t step = 0; step < 16 * 1024; ++step)
+        rb.push_back(step * 1000);
+    
+    // about one bit per value, the plain newest block dominates
+    EXPECT_LT(rb.memory_usage() * 8, rb.size() * sizeof(std::int64_t));
+    EXPECT_EQ(*(rb.begin() + 12345), 12345000);
+}
+
+TEST (RingBufferParallel, algorithmTests) {
+    RingBufferThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+    
+    // wrapped content spanning many chunks
+    RingBuffer<std::int64_t> rb(100000);
+    for (std::int64_t value = 0; value < 130000; ++value)
+        rb.push_back(value);
+    
+    parallel_for_each(pool, rb, [](std::int64_t &value) { value *= 2; });
+    EXPECT_EQ(rb.front(), 60000);
+    EXPECT_EQ(rb.back(), 259998);
+    
+    auto sum = std::accumulate(rb.begin(), rb.end(), std::int64_t(0));
+    std::plus<std::int64_t> add;
+    EXPECT_EQ(parallel_reduce(pool, rb, std::int64_t(0), add, add), sum);
+    EXPECT_EQ(parallel_reduce(rb, std::int64_t(0), add, add, true), sum);
+    
+    // the fold takes the accumulator first, unlike the merge of chunk results
+    auto squares = [](std::int64_t acc, std::int64_t value) { return acc + value * value; };
+    auto sumOfSquares = std::accumulate(rb.begin(), rb.end(), std::int64_t(0), squares);
+    EXPECT_EQ(parallel_reduce(pool, rb, std::int64_t(0), squares, add), sumOfSquares);
+    EXPECT_EQ(parallel_reduce(pool, rb, std::int64_t(0), squares, add, true), sumOfSquares);
+    
+    std::vector<double> halves(rb.size());
+    parallel_transform_into(pool, rb, halves.begin(), [](std::int64_t value) { return value / 2.0; });
+    EXPECT_EQ(halves.front(), 30000.0);
+    EXPECT_EQ(halves.back(), 129999.0);
+    EXPECT_TRUE(std::is_sorted(halves.begin(), halves.end()));
+    
+    EXPECT_EQ(parallel_count_if(pool, rb, [](std::int64_t value) { return value % 3 == 0; })
+              , std::size_t(std::count_if(rb.begin(), rb.end(), [](std::int64_t value) { return value % 3 == 0; })));
+    
+    RingBuffer<std::int64_t> empty(10);
+    EXPECT_EQ(parallel_count_if(pool, empty, [](std::int64_t) { return true; }), 0);
+    EXPECT_EQ(parallel_reduce(pool, empty, std::int64_t(0), add, add), 0);
+}
+
+TEST (RingBufferParallel, orderedTests) {
+    RingBufferThreadPool pool(3);
+    RingBuffer<std::string> rb(50000);
+    for (int value = 0; value < 70000; ++value)
+        rb.push_back(std::string(1, char('a' + value % 26)));
+    
+    // concatenation is associative but not commutative
+    auto concat = [](std::string left, const std::string &right) { return left + right; };
+    auto sequential = std::accumulate(rb.begin(), rb.end(), std::string());
+    EXPECT_EQ(parallel_reduce(pool, rb, std::string(), concat, concat, true), sequential);
+    
+    // string lengths summed, where the fold and the merge differ in type
+    auto lengths = [](std::size_t acc, const std::string &value) { return acc + value.size(); };
+    EXPECT_EQ(parallel_reduce(pool, rb, std::size_t(0), lengths, std::plus<std::size_t>()), 50000);
+    
+    EXPECT_THROW(parallel_for_each(pool, rb, [](std::string &value) {
+        if (value == "z")
+            throw std::runtime_error("callback failed");
+    }), std::runtime_error);
+    EXPECT_EQ(parallel_count_if(pool, rb, [](const std::string &value) { return value == "z"; }), 1923);
+}
+
+TEST (FrameRingBuffer, conversionTests) {
+    std::mt19937 random(3);
+    for (std::size_t channels : { 1, 2, 3, 4, 6, 8 })
+    {
+        // an odd capacity so the content wraps at odd frame counts
+        FrameRingBuffer<std::int16_t> rb(37, channels);
+        std::vector<std::int16_t> interleaved(60 * channels);
+        for (auto &sample : interleaved)
+            sample = std::int16_t(random());
+        
+        std::vector<std::vector<float>> planar(channels, std::vector<float>(60));
+        std::vector<float *> outputs;
+        for (auto &channel : planar)
+            outputs.push_back(channel.data());
+        
+        rb.push_frames(interleaved.data(), 30);
+        EXPECT_EQ(rb.pop_frames(outputs.data(), 20), 20);
+        for (std::size_t channel = 0; channel < channels; ++channel)
+        {
+            for (std::size_t frame = 0; frame < 20; ++frame)
+                ASSERT_EQ(planar[channel][frame], interleaved[frame * channels + channel] / 32768.0f);
+        }
+        
+        // frames 20 to 54, wrapped around the storage end, at half gain
+        rb.push_frames(interleaved.data() + 30 * channels, 25);
+        EXPECT_EQ(rb.size(), 35);
+        EXPECT_EQ(rb.pop_frames(outputs.data(), 60, 0.5f), 35);
+        for (std::size_t channel = 0; channel < channels; ++channel)
+        {
+            for (std::size_t frame = 0; frame < 35; ++frame)
+                ASSERT_EQ(planar[channel][frame], interleaved[(frame + 20) * channels + channel] * 0.5f / 32768.0f);
+        }
+        
+        // and back, planar to interleaved across the storage end
+        std::vector<const float *> inputs(outputs.begin(), outputs.end());
+        rb.push_frames(inputs.data(), 35, 2.0f);
+        std::vector<std::int16_t> popped(35 * channels);
+        EXPECT_EQ(rb.pop_frames(popped.data(), 35), 35);
+        EXPECT_TRUE(std::equal(popped.begin(), popped.end(), interleaved.begin() + 20 * channels));
+        EXPECT_TRUE(rb.empty());
+    }
+}
+
+TEST (FrameRingBuffer, formatTests) {
+    std::vector<float> left = { 0.5f, -0.25f, 1.5f, -2.0f, 0.0f, 1.0f / 1024 };
+    std::vector<float> right = { -0.5f, 0.75f, -1.0f, 0.125f, 1.0f, 0.0f };
+    const float *inputs[] = { left.data(), right.data() };
+    
+    FrameRingBuffer<std::int32_t> ints(4, 2);
+    ints.push_frames(inputs, 6);
+    // the two oldest frames were dropped
+    EXPECT_EQ(ints.size(), 4);
+    EXPECT_EQ(ints.frame(0)[0], 2147483647 - 127);
+    EXPECT_EQ(ints.frame(0)[1], -2147483647 - 1);
+    EXPECT_EQ(ints.frame(1)[0], -2147483647 - 1);
+    EXPECT_EQ(ints.frame(3)[0], 2097152);
+    EXPECT_EQ(ints.frames_one().second + ints.frames_two().second, 4);
+    
+    FrameRingBuffer<float> floats(8, 2);
+    floats.push_frames(inputs, 6, -2.0f);
+    std::vector<float> interleaved(12);
+    EXPECT_EQ(floats.pop_frames(interleaved.data(), 6), 6);
+    for (std::size_t frame = 0; frame < 6; ++frame)
+    {
+        EXPECT_EQ(interleaved[2 * frame], -2.0f * left[frame]);
+        EXPECT_EQ(interleaved[2 * frame + 1], -2.0f * right[frame]);
+    }
+    
+    EXPECT_THROW(FrameRingBuffer<float>(8, 0), std::invalid_argument);
+}
+
+TEST (PriorityRingBuffer, strictTests) {
+    typedef PriorityRingBuffer<int> Prioritized;
+    Prioritized rb(3, 100);
+    
+    // bulk first, control last
+    for (int value = 0; value < 50; ++value)
+        rb.push_back(2, 200 + value);
+    rb.push_back(1, 100);
+    rb.push_back(1, 101);
+    rb.push_back(0, 0);
+    rb.push_back(0, 1);
+    rb.push_back(0, 2);
+    EXPECT_EQ(rb.size(), 55);
+    
+    std::vector<int> popped;
+    EXPECT_EQ(rb.pop_batch(4, std::back_inserter(popped)), 4);
+    EXPECT_EQ(popped, std::vector<int>({ 0, 1, 2, 100 }));
+    
+    rb.push_back(0, 3);
+    int value = -1;
+    EXPECT_TRUE(rb.pop_front(value));
+    EXPECT_EQ(value, 3);
+    
+    popped.clear();
+    EXPECT_EQ(rb.pop_batch(1000, std::back_inserter(popped)), 51);
+    EXPECT_EQ(popped.front(), 101);
+    EXPECT_EQ(popped.back(), 249);
+    EXPECT_TRUE(rb.empty());
+    EXPECT_FALSE(rb.pop_front(value));
+}
+
+TEST (PriorityRingBuffer, overflowTests) {
+    typedef PriorityRingBuffer<std::string> Prioritized;
+    Prioritized rb({ 2, 2, 2 });
+    rb.set_overflow(1, Prioritized::overflow::reject);
+    rb.set_overflow(2, Prioritized::overflow::throw_error);
+    
+    for (auto text : { "a", "b", "c" })
+        EXPECT_TRUE(rb.push_back(0, text));
+    EXPECT_EQ(rb.lane(0).front(), "b");
+    EXPECT_EQ(rb.dropped(0), 1);
+    
+    EXPECT_TRUE(rb.push_back(1, "d"));
+    EXPECT_TRUE(rb.push_back(1, "e"));
+    EXPECT_FALSE(rb.push_back(1, "f"));
+    EXPECT_EQ(rb.lane(1).back(), "e");
+    EXPECT_EQ(rb.dropped(1), 1);
+    
+    rb.push_back(2, "g");
+    rb.push_back(2, "h");
+    EXPECT_THROW(rb.push_back(2, "i"), std::overflow_error);
+    EXPECT_EQ(rb.size(), 6);
+    
+    EXPECT_THROW(Prioritized(65, 1), std::invalid_argument);
+}
+
+TEST (PriorityRingBuffer, weightedTests) {
+    typedef PriorityRingBuffer<int> Prioritized;
+    Prioritized rb(3, 100);
+    rb.set_schedule(Prioritized::schedule::weighted);
+    rb.set_weight(0, 3);
+    rb.set_weight(2, 2);
+    
+    for (int value = 0; value < 10; ++value)
+    {
+        rb.push_back(0, value);
+        rb.push_back(2, 200 + value);
+    }
+    rb.push_back(1, 100);
+    
+    // quanta carry over between batches
+    std::vector<int> popped;
+    rb.pop_batch(2, std::back_inserter(popped));
+    rb.pop_batch(5, std::back_inserter(popped));
+    rb.pop_batch(4, std::back_inserter(popped));
+    EXPECT_EQ(popped, std::vector<int>({ 0, 1, 2, 100, 200, 201, 3, 4, 5, 202, 203 }));
+    
+    popped.clear();
+    rb.pop_batch(100, std::back_inserter(popped));
+    EXPECT_EQ(popped, std::vector<int>({ 6, 7, 8, 204, 205, 9, 206, 207, 208, 209 }));
+    EXPECT_TRUE(rb.empty());
+}
+
+TEST (PriorityRingBuffer, splitQuantumTests) {
+    typedef PriorityRingBuffer<int> Prioritized;
+    Prioritized rb(2, 100);
+    rb.set_schedule(Prioritized::schedule::weighted);
+    rb.set_weight(1, 3);
+    
+    for (int value = 100; value < 105; ++value)
+        rb.push_back(1, value);
+    
+    std::vector<int> popped;
+    rb.pop_batch(2, std::back_inserter(popped));
+    
+    // lane 1 keeps the rest of its quantum even though lane 0 comes first
+    rb.push_back(0, 0);
+    rb.pop_batch(2, std::back_inserter(popped));
+    rb.pop_batch(2, std::back_inserter(popped));
+    EXPECT_EQ(popped, std::vector<int>({ 100, 101, 102, 0, 103, 104 }));
+}
+
+TEST (RingBufferSerialization, fullTests) {
+    RingBuffer<int> rb(5);
+    for (int i = 1; i <= 8; ++i)
+        rb.push_back(i);
+    
+    std::stringstream stream;
+    serialize(stream, rb);
+    
+    RingBuffer<int> restored(5);
+    restored.push_back(42);
+    deserialize(stream, restored);
+    EXPECT_EQ(restored, rb);
+    EXPECT_EQ(restored.push_count(), 8);
+    EXPECT_EQ(restored.array_one().second, 5);
+    
+    RingBuffer<int> small(3);
+    stream.clear();
+    stream.seekg(0);
+    EXPECT_THROW(deserialize(stream, small), std::length_error);
+    
+    RingBuffer<std::string> strings(2);
+    strings.push_back("one");
+    strings.push_back("two two");
+    strings.push_back("three");
+    StringCodec codec;
+    std::stringstream stringStream;
+    serialize(stringStream, strings, codec);
+    RingBuffer<std::string> restoredStrings(2);
+    deserialize(stringStream, restoredStrings, codec);
+    EXPECT_EQ(restoredStrings, strings);
+}
+
+TEST (RingBufferSerialization, deltaTests) {
+    RingBuffer<int> rb(4);
+    for (int i = 1; i <= 3; ++i)
+        rb.push_back(i);
+    
+    std::stringstream full;
+    serialize(full, rb);
+    RingBuffer<int> replica(4);
+    deserialize(full, replica);
+    
+    auto checkpoint = rb.push_count();
+    rb.push_back(4);
+    rb.push_back(5);
+    rb.pop_front();
+    
+    std::stringstream delta;
+    serialize_delta(delta, rb, checkpoint);
+    std::string bytes = delta.str();
+    deserialize(delta, replica);
+    EXPECT_EQ(replica, rb);
+    EXPECT_EQ(replica.push_count(), rb.push_count());
+    
+    // applying the same delta again changes nothing
+    std::stringstream again(bytes);
+    deserialize(again, replica);
+    EXPECT_EQ(replica, rb);
+    
+    RingBuffer<int> stale(4);
+    std::stringstream gap(bytes);
+    EXPECT_THROW(deserialize(gap, stale), std::runtime_error);
+}
+
+TEST (RingBufferSerialization, mismatchedDeltaTests) {
+    RingBuffer<int> rb(4);
+    for (int i = 1; i <= 3; ++i)
+        rb.push_back(i);
+    auto checkpoint = rb.push_count();
+    rb.push_back(4);
+    
+    std::stringstream delta;
+    serialize_delta(delta, rb, checkpoint);
+    std::string bytes = delta.str();
+    
+    // a replica with more history than the source
+    RingBuffer<int> ahead(8);
+    for (int i = 100; i <= 105; ++i)
+        ahead.push_back(i);
+    std::stringstream forAhead(bytes);
+    EXPECT_THROW(deserialize(forAhead, ahead), std::runtime_error);
+    EXPECT_EQ(ahead.size(), 6);
+    EXPECT_EQ(ahead.front(), 100);
+    EXPECT_EQ(ahead.push_count(), 6);
+    
+    // a replica at the base which lost elements the source still has
+    RingBuffer<int> diverged(4);
+    for (int i = 1; i <= 3; ++i)
+        diverged.push_back(i);
+    diverged.pop_front();
+    diverged.pop_front();
+    std::stringstream forDiverged(bytes);
+    EXPECT_THROW(deserialize(forDiverged, diverged), std::runtime_error);
+    EXPECT_EQ(diverged.size(), 1);
+    EXPECT_EQ(diverged.push_count(), 3);
+}
+
+struct SeqlockSample
+{
+    long index;
+    long twice;
+};
+
+TEST (SeqlockRingBuffer, latestTests) {
+    SeqlockRingBuffer<int> rb(4);
+    int out[4] = {};
+    EXPECT_EQ(rb.read_latest(out, 4), 0);
+    EXPECT_FALSE(rb.read_back(out[0]));
+    
+    for (int i = 1; i <= 6; ++i)
+        rb.push_back(i);
+    EXPECT_EQ(rb.size(), 4);
+    EXPECT_EQ(rb.push_count(), 6);
+    
+    EXPECT_EQ(rb.read_latest(out, 3), 3);
+    EXPECT_EQ(out[0], 4);
+    EXPECT_EQ(out[2], 6);
+    EXPECT_EQ(rb.read_latest(out, 10), 4);
+    EXPECT_EQ(out[0], 3);
+}
+
+TEST (SeqlockRingBuffer, concurrentTests) {
+    SeqlockRingBuffer<SeqlockSample> rb(16);
+    std::atomic<bool> done(false);
+    std::atomic<int> inconsistent(0);
+    
+    auto reader = [&]() {
+        SeqlockSample out[8];
+        while (!done.load())
+        {
+            auto count = rb.read_latest(out, 8);
+            for (std::size_t pos = 0; pos < count; ++pos)
+            {
+                if (out[pos].twice != 2 * out[pos].index
+                    || (pos > 0 && out[pos].index != out[pos - 1].index + 1))
+                    ++inconsistent;
+            }
+        }
+    };
+    
+    std::thread first(reader);
+    std::thread second(reader);
+    for (long i = 0; i < 200000; ++i)
+        rb.push_back(SeqlockSample{i, 2 * i});
+    done = true;
+    first.join();
+    second.join();
+    
+    EXPECT_EQ(inconsistent.load(), 0);
+    SeqlockSample last;
+    EXPECT_TRUE(rb.read_back(last));
+    EXPECT_EQ(last.index, 199999);
+}
+
+TEST (SoARingBuffer, columnsTests) {
+    SoARingBuffer<long, double, std::string> rb(4);
+    EXPECT_EQ(rb.capacity(), 4);
+    EXPECT_THROW(rb.front(), std::range_error);
+    
+    for (long i = 1; i <= 6; ++i)
+        rb.push_back(std::make_tuple(i, i * 0.5, std::to_string(i)));
+    EXPECT_EQ(rb.size(), 4);
+    EXPECT_EQ(std::get<0>(rb.front()), 3);
+    EXPECT_EQ(std::get<2>(rb.back()), "6");
+    EXPECT_EQ(rb.get<1>(1), 2.0);
+    
+    auto one = rb.column_one<1>();
+    auto two = rb.column_two<1>();
+    EXPECT_EQ(one.second + two.second, 4);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(rb.column_two<0>().first) % SoARingBuffer<long>::column_alignment, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(two.first) % SoARingBuffer<long>::column_alignment, 0);
+    double sum = 0;
+    for (std::size_t pos = 0; pos < one.second; ++pos)
+        sum += one.first[pos];
+    for (std::size_t pos = 0; pos < two.second; ++pos)
+        sum += two.first[pos];
+    EXPECT_EQ(sum, 1.5 + 2.0 + 2.5 + 3.0);
+    
+    std::get<2>(rb[0]) = "three";
+    EXPECT_EQ(rb.get<2>(0), "three");
+    
+    rb.pop_front();
+    EXPECT_EQ(rb.size(), 3);
+    EXPECT_EQ(std::get<0>(rb.front()), 4);
+}
+
+#if defined(__cpp_lib_concepts)
+static_assert(std::random_access_iterator<SoARingBuffer<int, char>::iterator>, "SoA ring buffer iterator is random access");
+// rows of const references have no common reference with the value tuple
+// before the C++23 tuple changes, so only the ordering and distance parts
+static_assert(std::totally_ordered<SoARingBuffer<int, char>::const_iterator>, "SoA ring buffer const iterator is ordered");
+static_assert(std::sized_sentinel_for<SoARingBuffer<int, char>::const_iterator, SoARingBuffer<int, char>::const_iterator>, "SoA ring buffer const iterator has distance");
+#endif
+
+TEST (SoARingBuffer, iterTests) {
+    SoARingBuffer<int, char> rb(3);
+    for (int i = 0; i < 5; ++i)
+        rb.push_back(std::make_tuple(i, char('a' + i)));
+    
+    auto it = rb.begin();
+    EXPECT_EQ(std::get<0>(*it), 2);
+    EXPECT_EQ(std::get<1>(it[2]), 'e');
+    EXPECT_EQ(rb.end() - rb.begin(), 3);
+    EXPECT_TRUE(rb.end() > it);
+    EXPECT_TRUE(it <= it + 1);
+    EXPECT_TRUE(it + 2 >= 2 + it);
+    EXPECT_EQ(std::get<0>(*(1 + it)), 3);
+    
+    for (auto row : rb)
+        std::get<0>(row) *= 10;
+    
+    const SoARingBuffer<int, char> &crb = rb;
+    int total = 0;
+    for (auto cit = crb.begin(); cit != crb.end(); ++cit)
+        total += std::get<0>(*cit);
+    EXPECT_EQ(total, 90);
+    
+    SoARingBuffer<int, char> copy = rb;
+    EXPECT_EQ(std::get<0>(copy.front()), 20);
+    SoARingBuffer<int, char> moved = std::move(copy);
+    EXPECT_EQ(copy.size(), 0);
+    EXPECT_EQ(moved.size(), 3);
+}
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+struct QueueExecutor
+{
+    void post(std::coroutine_handle<> handle)
+    {
+        handles.push_back(handle);
+    }
+    
+    void run()
+    {
+        while (!handles.empty())
+        {
+            auto handle = handles.front();
+            handles.erase(handles.begin());
+            handle.resume();
+        }
+    }
+    
+    std::vector<std::coroutine_handle<>> handles;
+};
+
+TEST (AsyncRingBuffer, consumersTests) {
+    QueueExecutor executor;
+    AsyncRingBuffer<int, QueueExecutor> rb(2);
+    std::vector<int> popped;
+    auto consumer = [&](int id) -> DetachedTask {
+        int value = co_await rb.pop(executor);
+        popped.push_back(id * 100 + value);
+    };
+    
+    consumer(1);
+    consumer(2);
+    EXPECT_TRUE(executor.handles.empty());
+    
+    std::vector<int> values = {5, 6, 7};
+    auto rest = rb.try_push_range(values.begin(), values.end());
+    EXPECT_EQ(rest, values.end());
+    EXPECT_EQ(executor.handles.size(), 2);
+    EXPECT_EQ(rb.size(), 1);
+    
+    executor.run();
+    EXPECT_EQ(popped, std::vector<int>({105, 206}));
+    
+    int value = 0;
+    EXPECT_TRUE(rb.try_pop(value));
+    EXPECT_EQ(value, 7);
+    EXPECT_FALSE(rb.try_pop(value));
+}
+
+TEST (AsyncRingBuffer, producersTests) {
+    QueueExecutor executor;
+    AsyncRingBuffer<int, QueueExecutor> rb(1);
+    int pushed = 0;
+    auto producer = [&]() -> DetachedTask {
+        for (int i = 1; i <= 3; ++i)
+        {
+            co_await rb.push(i, executor);
+            ++pushed;
+        }
+    };
+    
+    producer();
+    EXPECT_EQ(pushed, 1);
+    EXPECT_FALSE(rb.try_push(10));
+    
+    for (int i = 1; i <= 3; ++i)
+    {
+        int value = 0;
+        EXPECT_TRUE(rb.try_pop(value));
+        EXPECT_EQ(value, i);
+        executor.run();
+    }
+    EXPECT_EQ(pushed, 3);
+    
+    bool thrown = false;
+    auto consumer = [&]() -> DetachedTask {
+        try
+        {
+            co_await rb.pop(executor);
+        }
+        catch (const std::range_error&)
+        {
+            thrown = true;
+        }
+    };
+    consumer();
+    rb.close();
+    executor.run();
+    EXPECT_TRUE(thrown);
+    EXPECT_FALSE(rb.try_push(1));
+}
+
+TEST (AsyncRingBuffer, moveOnlyTests) {
+    AsyncRingBuffer<std::unique_ptr<int>> rb(1);
+    std::unique_ptr<int> popped;
+    auto consumer = [&]() -> DetachedTask {
+        popped = co_await rb.pop();
+    };
+    
+    consumer();
+    EXPECT_TRUE(rb.try_push(std::unique_ptr<int>(new int(42))));
+    ASSERT_TRUE(popped != nullptr);
+    EXPECT_EQ(*popped, 42);
+}
+
+#endif
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();